@@ -0,0 +1,109 @@
+// Host benchmark: CSVIterator + stoull/stod + std::map (the old loaders)
+// versus csv::parse into a columnar table, on EuRoC data.csv files.
+//
+//   g++ -O2 -std=c++17 -Isrc bench/csv_bench.cpp -o csv_bench
+//   ./csv_bench mav0/imu0/data.csv mav0/state_groundtruth_estimate0/data.csv
+//
+// Both paths start from the file already in memory, so only parsing and
+// table building are timed. Each file is parsed `--reps` times (default 20)
+// and the best run is reported.
+
+#include "helper/csv_iterator.hpp"
+#include "helper/csv_table.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ILLIXR;
+using bench_clock = std::chrono::steady_clock;
+
+namespace {
+
+// Numeric columns after the timestamp on the file's first data row.
+size_t count_value_columns(const std::string& text) {
+    size_t start = text.find('\n');
+    if (start == std::string::npos) return 0;
+    size_t end = text.find('\n', start + 1);
+    std::string_view row{text.data() + start + 1, (end == std::string::npos ? text.size() : end) - start - 1};
+    return static_cast<size_t>(std::count(row.begin(), row.end(), ','));
+}
+
+std::map<uint64_t, std::vector<double>> parse_csv_iterator(const std::string& text, size_t columns) {
+    std::map<uint64_t, std::vector<double>> data;
+    std::istringstream                      in{text};
+    for (CSVIterator row{in, 1}; row != CSVIterator{}; ++row) {
+        if (row->size() < columns + 1) continue;
+        std::vector<double> v(columns);
+        for (size_t c = 0; c < columns; c++) v[c] = std::stod((*row)[c + 1]);
+        data[std::stoull((*row)[0])] = std::move(v);
+    }
+    return data;
+}
+
+template <typename F>
+double best_ms(int reps, F&& f) {
+    double best = 1e30;
+    for (int r = 0; r < reps; r++) {
+        auto t0 = bench_clock::now();
+        f();
+        double ms = std::chrono::duration<double, std::milli>(bench_clock::now() - t0).count();
+        if (ms < best) best = ms;
+    }
+    return best;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int                      reps = 20;
+    std::vector<const char*> files;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--reps") == 0 && i + 1 < argc) reps = std::atoi(argv[++i]);
+        else files.push_back(argv[i]);
+    }
+    if (files.empty()) {
+        std::fprintf(stderr, "usage: %s [--reps N] data.csv...\n", argv[0]);
+        return 1;
+    }
+
+    int status = 0;
+    for (const char* path : files) {
+        std::string text;
+        csv::Table  table;
+        if (!csv::load_file(path, 0, table, text)) {
+            std::fprintf(stderr, "%s: cannot read\n", path);
+            status = 1;
+            continue;
+        }
+        size_t columns = count_value_columns(text);
+
+        std::map<uint64_t, std::vector<double>> map;
+        double ms_old = best_ms(reps, [&] { map = parse_csv_iterator(text, columns); });
+        double ms_new = best_ms(reps, [&] { csv::parse(text, columns, table); });
+
+        // Both must agree row for row.
+        bool same = map.size() == table.rows();
+        size_t i = 0;
+        for (auto it = map.begin(); same && it != map.end(); ++it, ++i) {
+            same = it->first == table.ts[i];
+            for (size_t c = 0; same && c < columns; c++)
+                same = std::fabs(it->second[c] - table.at(c, i)) <= 1e-12 * (1.0 + std::fabs(it->second[c]));
+        }
+        if (!same) status = 1;
+
+        std::printf("%s\n", path);
+        std::printf("  rows=%zu  columns=1+%zu  size=%.1f KB  %s\n", table.rows(), columns,
+                    text.size() / 1024.0, same ? "results match" : "RESULTS DIFFER");
+        std::printf("  CSVIterator+map : %8.3f ms  (%6.1f MB/s)\n", ms_old, text.size() / 1e3 / ms_old);
+        std::printf("  csv::parse      : %8.3f ms  (%6.1f MB/s)  %.1fx\n", ms_new, text.size() / 1e3 / ms_new,
+                    ms_old / ms_new);
+    }
+    return status;
+}
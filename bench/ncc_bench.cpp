@@ -0,0 +1,230 @@
+// Host benchmark: the per-candidate ncc_match window search (the old
+// track_point_template) versus NccEngine, on a synthetic textured frame pair.
+//
+//   g++ -O2 -std=c++17 -Iplugins/openvins bench/ncc_bench.cpp -o ncc_bench
+//   ./ncc_bench [--reps N] [--points N] [--template S] [--radius R]
+//
+// The second frame is the first shifted by a few pixels with additive noise,
+// at EuRoC resolution. Both searches run over the same feature points with
+// the tracker's defaults (15 px template, 20 px radius); best positions must
+// agree exactly and scores to 1e-9. Each search set is run `--reps` times
+// (default 10) and the best run is reported.
+//
+// The RVV kernels run the same comparison under Spike (riscv-pk), next to the
+// scalar kernels:
+//
+//   riscv64-unknown-elf-g++ -O2 -std=c++17 -march=rv64gcv -DILLIXR_NCC_RVV -Iplugins/openvins
+//       bench/ncc_bench.cpp plugins/openvins/ncc_kernels_rvv.cpp plugins/openvins/ncc_rvv_hart.cpp
+//       -o ncc_bench
+//   spike --isa=rv64gcv pk ncc_bench --points 20 --reps 1
+
+#include "ncc_engine.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace OpenVINS;
+using bench_clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr int kCols = 752;
+constexpr int kRows = 480;
+
+// ncc_match() from SLAMMath.hpp, on GrayView instead of cv::Mat.
+double ncc_match_ref(const GrayView& img1, const GrayView& img2,
+                     int x1, int y1, int x2, int y2, int template_size) {
+    int half = template_size / 2;
+
+    if (x1 - half < 0 || x1 + half >= img1.cols ||
+        y1 - half < 0 || y1 + half >= img1.rows ||
+        x2 - half < 0 || x2 + half >= img2.cols ||
+        y2 - half < 0 || y2 + half >= img2.rows) {
+        return -1.0;
+    }
+
+    double sum1 = 0, sum2 = 0, sum12 = 0, sum11 = 0, sum22 = 0;
+    int count = template_size * template_size;
+
+    for (int dy = 0; dy < template_size; dy++) {
+        const uint8_t* row1 = img1.row(y1 - half + dy) + (x1 - half);
+        const uint8_t* row2 = img2.row(y2 - half + dy) + (x2 - half);
+        for (int dx = 0; dx < template_size; dx++) {
+            double v1 = row1[dx];
+            double v2 = row2[dx];
+            sum1 += v1;
+            sum2 += v2;
+            sum12 += v1 * v2;
+            sum11 += v1 * v1;
+            sum22 += v2 * v2;
+        }
+    }
+
+    double mean1 = sum1 / count;
+    double mean2 = sum2 / count;
+    double var1 = sum11 / count - mean1 * mean1;
+    double var2 = sum22 / count - mean2 * mean2;
+    double covar = sum12 / count - mean1 * mean2;
+
+    if (var1 < 1e-6 || var2 < 1e-6) return -1.0;
+
+    return covar / sqrt(var1 * var2);
+}
+
+// The window loop of the old track_point_template.
+double search_ref(const GrayView& prev, const GrayView& curr, int x0, int y0,
+                  int template_size, int search_radius, int& best_x, int& best_y) {
+    double best_score = -1.0;
+    best_x = x0;
+    best_y = y0;
+
+    for (int dy = -search_radius; dy <= search_radius; dy++) {
+        for (int dx = -search_radius; dx <= search_radius; dx++) {
+            int x = x0 + dx;
+            int y = y0 + dy;
+
+            double score = ncc_match_ref(prev, curr, x0, y0, x, y, template_size);
+
+            if (score > best_score) {
+                best_score = score;
+                best_x = x;
+                best_y = y;
+            }
+        }
+    }
+    return best_score;
+}
+
+// Box-blurred white noise: corner-like texture at a few pixels' scale.
+std::vector<uint8_t> make_frame(std::mt19937& rng) {
+    std::uniform_int_distribution<int> noise(0, 255);
+    std::vector<int> raw(static_cast<size_t>(kCols) * kRows);
+    for (int& v : raw) v = noise(rng);
+
+    std::vector<uint8_t> img(raw.size());
+    for (int y = 0; y < kRows; y++) {
+        for (int x = 0; x < kCols; x++) {
+            int sum = 0, n = 0;
+            for (int dy = -2; dy <= 2; dy++)
+                for (int dx = -2; dx <= 2; dx++) {
+                    int xx = x + dx, yy = y + dy;
+                    if (xx < 0 || yy < 0 || xx >= kCols || yy >= kRows) continue;
+                    sum += raw[static_cast<size_t>(yy) * kCols + xx];
+                    n++;
+                }
+            // Stretch the blurred histogram back over the 8-bit range.
+            int v = 128 + (sum / n - 128) * 4;
+            img[static_cast<size_t>(y) * kCols + x] = static_cast<uint8_t>(std::min(255, std::max(0, v)));
+        }
+    }
+    return img;
+}
+
+std::vector<uint8_t> shift_frame(const std::vector<uint8_t>& src, int sx, int sy, std::mt19937& rng) {
+    std::normal_distribution<double> noise(0.0, 3.0);
+    std::vector<uint8_t> img(src.size());
+    for (int y = 0; y < kRows; y++) {
+        for (int x = 0; x < kCols; x++) {
+            int xx = std::min(kCols - 1, std::max(0, x - sx));
+            int yy = std::min(kRows - 1, std::max(0, y - sy));
+            int v  = static_cast<int>(std::lround(src[static_cast<size_t>(yy) * kCols + xx] + noise(rng)));
+            img[static_cast<size_t>(y) * kCols + x] = static_cast<uint8_t>(std::min(255, std::max(0, v)));
+        }
+    }
+    return img;
+}
+
+template <typename F>
+double best_ms(int reps, F&& f) {
+    double best = 1e30;
+    for (int r = 0; r < reps; r++) {
+        auto t0 = bench_clock::now();
+        f();
+        double ms = std::chrono::duration<double, std::milli>(bench_clock::now() - t0).count();
+        if (ms < best) best = ms;
+    }
+    return best;
+}
+
+struct Match {
+    int    x, y;
+    double score;
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int reps = 10, points = 150, template_size = 15, radius = 20;
+    for (int i = 1; i < argc; i++) {
+        if      (std::strcmp(argv[i], "--reps")     == 0 && i + 1 < argc) reps          = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--points")   == 0 && i + 1 < argc) points        = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--template") == 0 && i + 1 < argc) template_size = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--radius")   == 0 && i + 1 < argc) radius        = std::atoi(argv[++i]);
+        else {
+            std::fprintf(stderr, "usage: %s [--reps N] [--points N] [--template S] [--radius R]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    std::mt19937         rng{42};
+    std::vector<uint8_t> prev_px = make_frame(rng);
+    std::vector<uint8_t> curr_px = shift_frame(prev_px, 3, -2, rng);
+    GrayView prev{prev_px.data(), kCols, kRows, kCols};
+    GrayView curr{curr_px.data(), kCols, kRows, kCols};
+
+    // Feature points anywhere in the frame, including near the borders where
+    // the window is clipped.
+    std::uniform_int_distribution<int> px(0, kCols - 1), py(0, kRows - 1);
+    std::vector<std::pair<int, int>> pts(static_cast<size_t>(points));
+    for (auto& p : pts) p = {px(rng), py(rng)};
+
+    std::vector<Match> ref(pts.size()), eng(pts.size()), scl(pts.size());
+    NccEngine ncc;
+    NccEngine ncc_scalar{ncc_scalar_kernels()};
+    const bool dispatched = &ncc.kernels() != &ncc_scalar.kernels();
+
+    double ms_ref = best_ms(reps, [&] {
+        for (size_t i = 0; i < pts.size(); i++)
+            ref[i].score = search_ref(prev, curr, pts[i].first, pts[i].second,
+                                      template_size, radius, ref[i].x, ref[i].y);
+    });
+    double ms_eng = best_ms(reps, [&] {
+        for (size_t i = 0; i < pts.size(); i++)
+            eng[i].score = ncc_search_window(ncc, prev, curr, pts[i].first, pts[i].second,
+                                             template_size, radius, eng[i].x, eng[i].y);
+    });
+    double ms_scl = !dispatched ? ms_eng : best_ms(reps, [&] {
+        for (size_t i = 0; i < pts.size(); i++)
+            scl[i].score = ncc_search_window(ncc_scalar, prev, curr, pts[i].first, pts[i].second,
+                                             template_size, radius, scl[i].x, scl[i].y);
+    });
+
+    size_t same = 0, tracked = 0;
+    double max_dscore = 0.0;
+    for (size_t i = 0; i < pts.size(); i++) {
+        if (ref[i].x == eng[i].x && ref[i].y == eng[i].y &&
+            (!dispatched || (scl[i].x == eng[i].x && scl[i].y == eng[i].y &&
+                             scl[i].score == eng[i].score))) same++;
+        if (ref[i].score >= 0.8) tracked++;
+        max_dscore = std::max(max_dscore, std::fabs(ref[i].score - eng[i].score));
+    }
+    bool ok = same == pts.size() && max_dscore <= 1e-9;
+
+    std::printf("%dx%d frame, %zu points, template %d, radius %d (%d candidates/point)\n",
+                kCols, kRows, pts.size(), template_size, radius, (2 * radius + 1) * (2 * radius + 1));
+    std::printf("  %s: positions %zu/%zu identical, max |dscore|=%.2e, %zu above 0.8\n",
+                ok ? "results match" : "RESULTS DIFFER", same, pts.size(), max_dscore, tracked);
+    std::printf("  ncc_match loop : %9.3f ms  (%7.1f us/search)\n", ms_ref, ms_ref * 1e3 / pts.size());
+    if (dispatched)
+        std::printf("  NccEngine %-6s: %9.3f ms  (%7.1f us/search)  %.1fx\n", "scalar", ms_scl,
+                    ms_scl * 1e3 / pts.size(), ms_ref / ms_scl);
+    std::printf("  NccEngine %-6s: %9.3f ms  (%7.1f us/search)  %.1fx\n", ncc.kernels().name,
+                ms_eng, ms_eng * 1e3 / pts.size(), ms_ref / ms_eng);
+    return ok ? 0 : 1;
+}
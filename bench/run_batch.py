@@ -0,0 +1,293 @@
+#!/usr/bin/env python3
+"""
+run_batch.py
+
+Builds and runs every (sequence, configuration) pair of a batch file back to
+back, parses the run logs and writes one report for the whole batch, so
+results can be compared across commits.
+
+Usage:
+  python3 bench/run_batch.py <batch.yaml> [--out DIR] [--only SUBSTR]
+                             [--skip-build] [--dry-run]
+
+  --out DIR      where builds, logs and reports go (default bench_out/<commit>)
+  --only SUBSTR  run only the pairs whose "<sequence>/<config>" contains SUBSTR
+  --skip-build   reuse the existing build directories
+  --dry-run      print the commands without running them
+
+The batch file (see bench/batch.example.yaml) lists:
+  board      west board, e.g. spike_riscv64 or native_sim
+  run        command that runs a finished build; {build} is replaced by the
+             build directory (default: west build -d {build} -t run)
+  timeout_s  per run
+  sequences  name + EuRoC mav0 dir relative to the app dir (packed once with
+             pack_euroc_data.py and embedded with -DILLIXR_DATASET_PACK), or
+             no mav0 for configs that generate their own data
+             (synthetic_sensors)
+  configs    name + base profile + key overrides merged into it
+
+Each pair gets its own build directory and generated profile. The report is
+written as report.json (one object per run, nested) and report.csv (one row
+per run, flattened columns) next to the per-run logs. Metrics come from the
+lines the runtime already prints:
+
+  [runtime] pipeline time           wall time of the data flow
+  [OpenVINS] ... after N frames     frames processed
+  [OpenVINS] tracking ...           tracker, front-end ms/frame, tracks kept
+  [latency] stage=...               per-stage p50 / p99 / max (last report)
+  [trajectory_eval] ...             ATE / RPE per estimator stream
+  [lock_audit] ...                  contention totals
+  [offline_cam] / [synthetic_sensors] frame counts, decode / render time
+"""
+
+import argparse
+import csv
+import datetime
+import json
+import os
+import re
+import shlex
+import subprocess
+import sys
+import time
+
+import yaml
+
+APP_DIR   = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+PACK_TOOL = os.path.join(APP_DIR, "plugins", "openvins", "pack_euroc_data.py")
+
+DEFAULT_RUN = "west build -d {build} -t run"
+
+# ── Log parsing ──────────────────────────────────────────────────────────────
+
+NUM = r"([-+0-9.eE]+|nan|inf)"
+
+RE_PIPELINE = re.compile(r"\[runtime\] pipeline time: " + NUM + r" s")
+RE_FRAMES   = re.compile(r"\[OpenVINS\] (?:camera stream ended after (\d+) frames|all (\d+) camera frames processed)")
+RE_LATENCY  = re.compile(r"\[latency\] stage=(\S+)\s+n=(\d+)(?: p50=" + NUM + " p99=" + NUM + " max=" + NUM + ")?")
+RE_EVAL_HDR = re.compile(r"\[trajectory_eval\] (\S+)\s+poses=(\d+) \(missed (\d+)\)")
+RE_EVAL_ATE = re.compile(r"\[trajectory_eval\]\s+ATE\s+rmse=" + NUM + r" m\s+\((\w+), scale=" + NUM + r"\)")
+RE_EVAL_RPE = re.compile(r"\[trajectory_eval\]\s+RPE\s+window=" + NUM + r" s\s+pairs=(\d+)\s+trans rmse=" + NUM +
+                         " max=" + NUM + r" m\s+rot rmse=" + NUM + " max=" + NUM + " deg")
+RE_LOCK     = re.compile(r"\[lock_audit\] (\S+)\s+(\S+)\s+acq=(\d+) contended=(\d+) wait_total=" + NUM +
+                         " wait_max=" + NUM)
+RE_CAM_END  = re.compile(r"\[offline_cam\] end of stream\s+sent=(\d+) dropped=(\d+)")
+RE_DECODE   = re.compile(r"\[offline_cam\] decode\s+format=(\S+)\s+avg=" + NUM + " us/image")
+RE_TRACK    = re.compile(r"\[OpenVINS\] tracking\s+tracker=(\S+)\s+avg=" + NUM + r" ms/frame over (\d+) frames\s+"
+                         r"kept=(\d+)/(\d+) tracks")
+RE_RENDER   = re.compile(r"\[synthetic_sensors\] end of stream\s+frames=(\d+)\s+render avg=" + NUM + " ms")
+
+
+def parse_log(text):
+    m = {"latency": {}, "trajectory": {}, "locks": {"contended": 0, "wait_total_us": 0.0}}
+    stream = None
+
+    for line in text.splitlines():
+        if r := RE_PIPELINE.search(line):
+            m["pipeline_s"] = float(r.group(1))
+        elif r := RE_FRAMES.search(line):
+            m["frames"] = int(r.group(1) or r.group(2))
+        elif r := RE_LATENCY.search(line):
+            # Reported by openvins and again at shutdown; the last one wins.
+            st = {"n": int(r.group(2))}
+            if r.group(3) is not None:
+                st.update(p50_us=float(r.group(3)), p99_us=float(r.group(4)), max_us=float(r.group(5)))
+            m["latency"][r.group(1)] = st
+        elif r := RE_EVAL_HDR.search(line):
+            stream = r.group(1)
+            m["trajectory"][stream] = {"poses": int(r.group(2)), "missed": int(r.group(3))}
+        elif (r := RE_EVAL_ATE.search(line)) and stream:
+            m["trajectory"][stream].update(ate_rmse_m=float(r.group(1)), align=r.group(2),
+                                           scale=float(r.group(3)))
+        elif (r := RE_EVAL_RPE.search(line)) and stream:
+            m["trajectory"][stream].update(rpe_window_s=float(r.group(1)), rpe_pairs=int(r.group(2)),
+                                           rpe_trans_rmse_m=float(r.group(3)),
+                                           rpe_trans_max_m=float(r.group(4)),
+                                           rpe_rot_rmse_deg=float(r.group(5)),
+                                           rpe_rot_max_deg=float(r.group(6)))
+        elif r := RE_LOCK.search(line):
+            m["locks"]["contended"]     += int(r.group(4))
+            m["locks"]["wait_total_us"] += float(r.group(5))
+        elif r := RE_CAM_END.search(line):
+            m["cam_sent"], m["cam_dropped"] = int(r.group(1)), int(r.group(2))
+        elif r := RE_DECODE.search(line):
+            m["decode_format"], m["decode_us_per_image"] = r.group(1), float(r.group(2))
+        elif r := RE_TRACK.search(line):
+            m["tracker"], m["track_ms_per_frame"] = r.group(1), float(r.group(2))
+            m["tracks_kept"], m["tracks_tried"] = int(r.group(4)), int(r.group(5))
+        elif r := RE_RENDER.search(line):
+            m["cam_sent"], m["render_ms_per_frame"] = int(r.group(1)), float(r.group(2))
+
+    if "pipeline_s" in m and m.get("frames"):
+        m["frames_per_s"] = m["frames"] / m["pipeline_s"] if m["pipeline_s"] > 0 else None
+    return m
+
+
+def flatten(d, prefix=""):
+    out = {}
+    for k, v in d.items():
+        key = f"{prefix}{k}"
+        if isinstance(v, dict):
+            out.update(flatten(v, key + "."))
+        else:
+            out[key] = v
+    return out
+
+# ── Running ──────────────────────────────────────────────────────────────────
+
+def run(cmd, log=None, timeout=None, dry=False, cwd=None):
+    print("[run_batch] $ " + " ".join(shlex.quote(c) for c in cmd))
+    if dry:
+        return 0, ""
+    try:
+        p = subprocess.run(cmd, cwd=cwd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                           text=True, errors="replace", timeout=timeout)
+        out, rc = p.stdout, p.returncode
+    except subprocess.TimeoutExpired as e:
+        out = e.stdout if isinstance(e.stdout, str) else (e.stdout or b"").decode(errors="replace")
+        rc  = "timeout"
+    if log:
+        with open(log, "w") as f:
+            f.write(out)
+    return rc, out
+
+
+def git_commit():
+    try:
+        return subprocess.check_output(["git", "-C", APP_DIR, "rev-parse", "--short", "HEAD"],
+                                       text=True).strip()
+    except (OSError, subprocess.CalledProcessError):
+        return "unknown"
+
+
+def pack_sequence(seq, out_dir, dry):
+    if not seq.get("mav0"):
+        return None
+    pack = os.path.join(out_dir, "packs", seq["name"] + ".illixrpack")
+    if os.path.exists(pack):
+        return pack
+    os.makedirs(os.path.dirname(pack), exist_ok=True)
+    cmd = [sys.executable, PACK_TOOL, os.path.join(APP_DIR, seq["mav0"]), pack]
+    for key in ("num_frames", "imu_chunk"):
+        if key in seq:
+            cmd += ["--" + key.replace("_", "-"), str(seq[key])]
+    if "cam_encoding" in seq:
+        cmd += ["--cam-encoding", seq["cam_encoding"]]
+    if seq.get("lz4"):
+        cmd.append("--lz4")
+    rc, _ = run(cmd, log=pack + ".log", dry=dry, cwd=os.path.dirname(PACK_TOOL))
+    return pack if rc == 0 else None
+
+
+def write_profile(cfg, seq, path):
+    with open(os.path.join(APP_DIR, cfg["profile"])) as f:
+        profile = yaml.safe_load(f) or {}
+    profile.update(cfg.get("overrides") or {})
+    if seq.get("mav0"):
+        profile["data"] = os.path.join(APP_DIR, seq["mav0"])
+    with open(path, "w") as f:
+        f.write(f"# Generated by run_batch.py: {cfg['profile']} + overrides for {seq['name']}\n")
+        yaml.safe_dump(profile, f, sort_keys=False)
+
+
+def run_pair(batch, seq, cfg, out_dir, args):
+    name   = f"{seq['name']}/{cfg['name']}"
+    tag    = f"{seq['name']}__{cfg['name']}"
+    build  = os.path.join(out_dir, "build", tag)
+    result = {"sequence": seq["name"], "config": cfg["name"], "status": "ok"}
+
+    pack = pack_sequence(seq, out_dir, args.dry_run)
+    if seq.get("mav0") and not pack:
+        result["status"] = "pack_failed"
+        return result
+
+    os.makedirs(os.path.join(out_dir, "logs"), exist_ok=True)
+    os.makedirs(os.path.join(out_dir, "profiles"), exist_ok=True)
+    profile = os.path.join(out_dir, "profiles", tag + ".yaml")
+    write_profile(cfg, seq, profile)
+
+    if not args.skip_build:
+        cmd = ["west", "build", "-p", "always", "-b", batch["board"], "-d", build, APP_DIR,
+               "--", f"-DYAML_FILE={profile}"]
+        if pack:
+            cmd.append(f"-DILLIXR_DATASET_PACK={pack}")
+        cmd += cfg.get("cmake_args", [])
+        t0 = time.monotonic()
+        rc, _ = run(cmd, log=os.path.join(out_dir, "logs", tag + ".build.log"), dry=args.dry_run)
+        result["build_s"] = round(time.monotonic() - t0, 1)
+        if rc != 0:
+            result["status"] = "build_failed"
+            return result
+
+    run_cmd = shlex.split(batch.get("run", DEFAULT_RUN).format(build=build))
+    t0 = time.monotonic()
+    rc, out = run(run_cmd, log=os.path.join(out_dir, "logs", tag + ".run.log"),
+                  timeout=batch.get("timeout_s", 3600), dry=args.dry_run)
+    result["host_s"] = round(time.monotonic() - t0, 1)
+    if rc == "timeout":
+        result["status"] = "timeout"
+    elif rc != 0 and "========== Runtime Complete" not in out:
+        # Spike / FireSim exit codes are not meaningful; the banner is.
+        result["status"] = f"exit_{rc}"
+
+    result.update(parse_log(out))
+    print(f"[run_batch] {name}: {result['status']}  pipeline={result.get('pipeline_s')} s  "
+          f"frames={result.get('frames')}")
+    return result
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Run a batch of ILLIXR sequences/configurations")
+    parser.add_argument("batch")
+    parser.add_argument("--out")
+    parser.add_argument("--only")
+    parser.add_argument("--skip-build", action="store_true")
+    parser.add_argument("--dry-run", action="store_true")
+    args = parser.parse_args()
+
+    with open(args.batch) as f:
+        batch = yaml.safe_load(f)
+    for key in ("board", "sequences", "configs"):
+        if key not in batch:
+            print(f"[run_batch] {args.batch}: missing '{key}'")
+            sys.exit(1)
+
+    commit  = git_commit()
+    out_dir = os.path.abspath(args.out or os.path.join("bench_out", commit))
+    os.makedirs(out_dir, exist_ok=True)
+
+    runs = []
+    for seq in batch["sequences"]:
+        for cfg in batch["configs"]:
+            if cfg.get("sequences") and seq["name"] not in cfg["sequences"]:
+                continue
+            if args.only and args.only not in f"{seq['name']}/{cfg['name']}":
+                continue
+            runs.append(run_pair(batch, seq, cfg, out_dir, args))
+
+    report = {
+        "commit": commit,
+        "date":   datetime.datetime.now(datetime.timezone.utc).isoformat(timespec="seconds"),
+        "board":  batch["board"],
+        "batch":  os.path.abspath(args.batch),
+        "runs":   runs,
+    }
+    with open(os.path.join(out_dir, "report.json"), "w") as f:
+        json.dump(report, f, indent=2)
+
+    rows    = [dict(commit=commit, board=batch["board"], **flatten(r)) for r in runs]
+    columns = []
+    for row in rows:
+        columns += [c for c in row if c not in columns]
+    with open(os.path.join(out_dir, "report.csv"), "w", newline="") as f:
+        writer = csv.DictWriter(f, fieldnames=columns)
+        writer.writeheader()
+        writer.writerows(rows)
+
+    failed = sum(r["status"] != "ok" for r in runs)
+    print(f"[run_batch] {len(runs)} runs, {failed} failed — report in {out_dir}/report.{{json,csv}}")
+    sys.exit(1 if failed else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,176 @@
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <chrono>
+#include <vector>
+#include <Eigen/Dense>
+#include <Eigen/Geometry>
+
+#include "../../src/threadloop.hpp"
+#include "../../src/phonebook_new.hpp"
+#include "../../src/plugin_registry.hpp"
+#include "../../src/data_format.hpp"
+#include "../../src/ground_truth.hpp"
+#include "../../src/mtime.hpp"
+#include "../../src/helper/time_series.hpp"
+
+#ifdef ILLIXR_DATASET_PACK
+#include "../../src/dataset_pack.hpp"
+#endif
+
+using namespace ILLIXR;
+
+// ==============================================================================
+// GROUND TRUTH SERVICE
+//
+// Loads the pack's ground-truth stream once into a flat time series and
+// answers GroundTruth::pose_at() on the caller's thread. Queries mostly move
+// forward in time, so a shared hint makes each lookup O(1); it is only a
+// starting point for the search, so concurrent callers racing on it is
+// harmless.
+//
+// The thread only registers the openvins_pose subscription and exits. For
+// each openvins pose the callback (on the openvins thread) publishes the
+// ground truth at the same timestamp on "true_pose".
+// ==============================================================================
+
+K_THREAD_STACK_DEFINE(ground_truth_stack, 8192);
+
+class GroundTruthPlugin : public threadloop, public GroundTruth {
+public:
+    // Channels: position x/y/z, orientation w/x/y/z.
+    using Series = TimeSeries<7>;
+
+    explicit GroundTruthPlugin(phonebook_new& pb)
+        : threadloop{pb, "ground_truth",
+                     ground_truth_stack,
+                     K_THREAD_STACK_SIZEOF(ground_truth_stack),
+                     5}
+        , missed_{0}
+    {
+        atomic_set(&hint_, 0);
+        load();
+        pb.register_impl<GroundTruth>(this);
+
+        if (available()) {
+            printf("[ground_truth] constructed  poses=%zu  span=%.3f s\n",
+                   series_.size(), (last_ts_ns() - first_ts_ns()) * 1e-9);
+        } else {
+            printf("[ground_truth] constructed  no ground truth available\n");
+        }
+    }
+
+    void _p_thread_setup() override {
+        node().subscribe_to<PoseMsg>("openvins", "openvins_pose",
+                                     &GroundTruthPlugin::on_vio_pose_cb, this);
+    }
+
+    skip_option _p_should_skip() override {
+        return skip_option::stop;
+    }
+
+    void _p_one_iteration() override { }
+
+    bool pose_at(int64_t t_ns, PoseMsg& out) const override {
+        if (!available() || t_ns < first_ts_ns() || t_ns > last_ts_ns())
+            return false;
+
+        Series::Bracket b = series_.bracket(static_cast<uint64_t>(t_ns),
+                                            static_cast<size_t>(atomic_get(&hint_)));
+        atomic_set(&hint_, static_cast<atomic_val_t>(b.lo));
+
+        Eigen::Quaternionf q0 = orientation_at(b.lo);
+        Eigen::Quaternionf q1 = orientation_at(b.hi);
+
+        out.timestamp   = time_point{std::chrono::nanoseconds{t_ns}};
+        out.position    = Eigen::Vector3f{series_.interpolate(0, b),
+                                          series_.interpolate(1, b),
+                                          series_.interpolate(2, b)};
+        out.orientation = q0.slerp(b.alpha, q1).normalized();
+        out.prov        = Provenance{t_ns, read_mtime(), static_cast<uint32_t>(b.lo)};
+        return true;
+    }
+
+    bool available() const override {
+        return !series_.empty();
+    }
+
+    int64_t first_ts_ns() const override {
+        return available() ? static_cast<int64_t>(series_.front_time()) : 0;
+    }
+
+    int64_t last_ts_ns() const override {
+        return available() ? static_cast<int64_t>(series_.back_time()) : 0;
+    }
+
+private:
+    Series           series_;
+    mutable atomic_t hint_;
+    size_t           missed_;     // openvins thread only
+
+    Eigen::Quaternionf orientation_at(size_t i) const {
+        return Eigen::Quaternionf{series_.value(3, i), series_.value(4, i),
+                                  series_.value(5, i), series_.value(6, i)};
+    }
+
+#ifdef ILLIXR_DATASET_PACK
+    void load() {
+        const pack::Reader& p = get_dataset_pack();
+        size_t chunks = p.chunks(pack::Stream::gt);
+
+        size_t total = 0;
+        for (size_t c = 0; c < chunks; c++) total += p.chunk(pack::Stream::gt, c).records;
+        series_.reserve(total);
+
+        std::vector<uint8_t> scratch, out;
+        for (size_t c = 0; c < chunks; c++) {
+            const pack::ChunkEntry& e = p.chunk(pack::Stream::gt, c);
+            if (e.raw_size < e.records * sizeof(pack::GroundTruthRecord)) continue;
+            const uint8_t* data = p.load(e, scratch, out);
+            if (!data) {
+                printf("[ground_truth] ERROR: cannot load chunk %zu\n", c);
+                continue;
+            }
+            for (size_t r = 0; r < e.records; r++) {
+                pack::GroundTruthRecord rec;
+                std::memcpy(&rec, data + r * sizeof(rec), sizeof(rec));
+                uint64_t ts = static_cast<uint64_t>(rec.ts_ns);
+                if (!series_.empty() && ts <= series_.back_time()) continue;
+                series_.push_back(ts, {rec.p[0], rec.p[1], rec.p[2],
+                                       rec.q[0], rec.q[1], rec.q[2], rec.q[3]});
+            }
+        }
+    }
+#else
+    void load() {
+        printf("[ground_truth] built without ILLIXR_DATASET_PACK — "
+               "pack the sequence with pack_euroc_data.py to enable ground truth\n");
+    }
+#endif
+
+    static void on_vio_pose_cb(void* ctx, const PoseMsg& msg) {
+        static_cast<GroundTruthPlugin*>(ctx)->on_vio_pose(msg);
+    }
+
+    void on_vio_pose(const PoseMsg& vio) {
+        PoseMsg gt;
+        if (!pose_at(vio.timestamp.time_since_epoch().count(), gt)) {
+            if (missed_++ == 0 && available())
+                printf("[ground_truth] no ground truth at t=%ld ns (outside span)\n",
+                       (long)vio.timestamp.time_since_epoch().count());
+            return;
+        }
+        // Keep the openvins provenance so consumers can pair the two poses.
+        gt.prov = vio.prov;
+        node().publish_to<PoseMsg>("true_pose", gt);
+    }
+};
+
+void start_ground_truth(phonebook_new& pb) {
+    static GroundTruthPlugin instance{pb};
+    instance.start();
+}
+
+REGISTER_PLUGIN(ground_truth);
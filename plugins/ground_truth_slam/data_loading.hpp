@@ -1,15 +1,15 @@
 #pragma once
 
-#include "illixr/csv_iterator.hpp"
+#include "illixr/csv_table.hpp"
 #include "illixr/data_format.hpp"
 #include "illixr/error_util.hpp"
+#include "illixr/time_series.hpp"
 
 #include <eigen3/Eigen/Dense>
-#include <fstream>
 #include <iostream>
-#include <map>
 #include <spdlog/spdlog.h>
 #include <string>
+#include <utility>
 
 // timestamp
 // p_RS_R_x [m], p_RS_R_y [m], p_RS_R_z [m]
@@ -20,9 +20,10 @@
 
 using namespace ILLIXR;
 
-typedef pose_type sensor_types;
+// Channels: position x/y/z, then orientation w/x/y/z.
+typedef TimeSeries<7> sensor_types;
 
-static std::map<ullong, sensor_types> load_data() {
+static sensor_types load_data() {
     const char* illixr_data_c_str = std::getenv("ILLIXR_DATA");
     if (!illixr_data_c_str) {
         ILLIXR::abort("Please define ILLIXR_DATA");
@@ -30,21 +31,19 @@ static std::map<ullong, sensor_types> load_data() {
     const std::string subpath     = "/state_groundtruth_estimate0/data.csv";
     std::string       illixr_data = std::string{illixr_data_c_str};
 
-    std::map<ullong, sensor_types> data;
-
-    std::ifstream gt_file{illixr_data + subpath};
-
-    if (!gt_file.good()) {
+    // Timestamp, position, orientation; the velocity/bias columns are not used.
+    csv::Table  table;
+    std::string buffer;
+    if (!csv::load_file(illixr_data + subpath, 7, table, buffer)) {
         spdlog::get("illixr")->error("[groundtruthslam] ${ILLIXR_DATA} {0} ({1}{0}) is not a good path", subpath, illixr_data);
         ILLIXR::abort();
     }
 
-    for (CSVIterator row{gt_file, 1}; row != CSVIterator{}; ++row) {
-        ullong             t = std::stoull(row[0]);
-        Eigen::Vector3f    av{std::stof(row[1]), std::stof(row[2]), std::stof(row[3])};
-        Eigen::Quaternionf la{std::stof(row[4]), std::stof(row[5]), std::stof(row[6]), std::stof(row[7])};
-        data[t] = {{}, av, la};
-    }
+    return sensor_types::from_table(std::move(table));
+}
 
-    return data;
+static pose_type pose_at_row(const sensor_types& data, size_t i) {
+    return pose_type{{},
+                     Eigen::Vector3f{data.value(0, i), data.value(1, i), data.value(2, i)},
+                     Eigen::Quaternionf{data.value(3, i), data.value(4, i), data.value(5, i), data.value(6, i)}};
 }
@@ -28,6 +28,7 @@ public:
         // Therefore we need the IMU dataset_first_time to reproduce the real dataset time.
         // TODO: Change the hardcoded number to be read from some configuration variables in the yaml file.
         , _m_dataset_first_time{ViconRoom1Medium}
+        , _m_lookup_hint{0}
         , _m_first_time{true} {
         spdlogger(std::getenv("GROUND_TRUTH_SLAM_LOG_LEVEL"));
     }
@@ -41,16 +42,20 @@ public:
 
     void feed_ground_truth(const switchboard::ptr<const imu_type>& datum) {
         ullong rounded_time = datum->time.time_since_epoch().count() + _m_dataset_first_time;
-        auto   it           = _m_sensor_data.find(rounded_time);
-        if (it == _m_sensor_data.end()) {
+        size_t row          = _m_sensor_data.find(rounded_time, _m_lookup_hint);
+        if (row == sensor_types::npos) {
 #ifndef NDEBUG
             spdlog::get(name)->debug("True pose not found at timestamp: {}", rounded_time);
 #endif
             return;
         }
+        // IMU and ground truth both advance at a fixed rate, so the next
+        // lookup is usually the next row.
+        _m_lookup_hint = row;
 
+        pose_type                   gt_pose   = pose_at_row(_m_sensor_data, row);
         switchboard::ptr<pose_type> true_pose =
-            _m_true_pose.allocate<pose_type>(pose_type{time_point{datum->time}, it->second.position, it->second.orientation});
+            _m_true_pose.allocate<pose_type>(pose_type{time_point{datum->time}, gt_pose.position, gt_pose.orientation});
 
 #ifndef NDEBUG
         spdlog::get(name)->debug("Ground truth pose was found at T: {} | Pos: ({}, {}, {}) | Quat: ({}, {}, {}, {})",
@@ -74,8 +79,9 @@ private:
     switchboard::writer<pose_type>     _m_true_pose;
 
     switchboard::writer<switchboard::event_wrapper<Eigen::Vector3f>> _m_ground_truth_offset;
-    const std::map<ullong, sensor_types>                             _m_sensor_data;
+    const sensor_types                                               _m_sensor_data;
     ullong                                                           _m_dataset_first_time;
+    size_t                                                           _m_lookup_hint;
     bool                                                             _m_first_time;
 };
 
@@ -10,12 +10,20 @@
 #include "../../src/phonebook_new.hpp"
 #include "../../src/plugin_registry.hpp"
 #include "../../src/data_format.hpp"
+#include "../../src/latency_tracker.hpp"
+#include "../../src/mtime.hpp"
+#include "../../src/lock_audit.hpp"
 
 using namespace ILLIXR;
 
 // offline_imu pushes ImuMsg* into this queue AND into openvins_imu_queue
 K_MSGQ_DEFINE(imu_integrator_queue, sizeof(ImuMsg*), 500, 4);
 
+// Camera provenance of the last VIO reset, until a renderer pose uses it.
+// on_vio_state runs on the openvins thread (phonebook callback); the queue
+// hands the provenance to this plugin's thread. Newest wins.
+K_MSGQ_DEFINE(imu_integrator_vio_prov_queue, sizeof(Provenance), 1, 8);
+
 K_THREAD_STACK_DEFINE(imu_integrator_stack, 65536);
 
 class ImuIntegrator : public threadloop {
@@ -58,7 +66,7 @@ public:
 
     void _p_one_iteration() override {
         ImuMsg* imu = nullptr;
-        if (k_msgq_get(&imu_integrator_queue, &imu, K_NO_WAIT) != 0 || !imu)
+        if (audit_msgq_get(&imu_integrator_queue, &imu, K_NO_WAIT, "imu_integrator_queue") != 0 || !imu)
             return;
 
         double t = static_cast<double>(
@@ -75,6 +83,7 @@ public:
         // ── Remove biases ─────────────────────────────────────────────────
         Eigen::Vector3d gyro  = imu->angular_v - bias_gyro_;
         Eigen::Vector3d accel = imu->linear_a  - bias_accel_;
+        Provenance      imu_prov = imu->prov;
         delete imu;
 
         // ── Rotate accel IMU → global frame ──────────────────────────────
@@ -103,11 +112,21 @@ public:
             ILLIXR::time_point{std::chrono::nanoseconds{
                 static_cast<long long>(t * 1e9)}},
             position_.cast<float>(),
-            orientation_.cast<float>().normalized()
+            orientation_.cast<float>().normalized(),
+            imu_prov
         };
         // "renderer" is the receiver name (matches REGISTER_PLUGIN(renderer))
         node().publish_to<PoseMsg>("renderer", out);
 
+        // IMU sample → renderer pose, and for the first pose after a VIO
+        // reset, camera frame → renderer pose (end-to-end).
+        uint64_t now = read_mtime();
+        LatencyTracker& lt = get_latency_tracker();
+        lt.record(LatencyStage::imu_to_render, imu_prov.ingest_mtime, now);
+        Provenance vio_prov;
+        if (k_msgq_get(&imu_integrator_vio_prov_queue, &vio_prov, K_NO_WAIT) == 0)
+            lt.record(LatencyStage::cam_to_render, vio_prov.ingest_mtime, now);
+
         printf("[ImuIntegrator] t=%.4f  pos=[%.3f,%.3f,%.3f]\n",
                t, position_.x(), position_.y(), position_.z());
     }
@@ -138,6 +157,9 @@ private:
         bias_gyro_   = msg.bias_gyro;           // Vector3d
         bias_accel_  = msg.bias_accel;          // Vector3d
         gravity_     = msg.params.n_gravity;    // {0,0,-9.81} Vector3d
+        // Camera frame behind this state; replaces one no pose has used yet.
+        while (k_msgq_put(&imu_integrator_vio_prov_queue, &msg.prov, K_NO_WAIT) != 0)
+            k_msgq_purge(&imu_integrator_vio_prov_queue);
 
         last_t_ = static_cast<double>(
             msg.timestamp.time_since_epoch().count()) * 1e-9;
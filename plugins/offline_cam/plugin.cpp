@@ -1,10 +1,13 @@
 #include <zephyr/kernel.h>
 #include <cstdint>
 #include <chrono>
+#include <cstring>
+#include <vector>
 
 #include <opencv2/core.hpp>
 #include <opencv2/imgproc.hpp>
-#include <opencv2/imgcodecs.hpp>
+
+#include <png.h>
 
 #include "../../src/data_format_opencv.hpp"
 #include "../../src/helper/opencv_helper.hpp"
@@ -12,14 +15,203 @@
 #include "../../src/phonebook_new.hpp"
 #include "../../src/plugin_registry.hpp"
 #include "../../src/stoplight.hpp"
+#include "../../src/mtime.hpp"
+#include "../../src/lock_audit.hpp"
+#include "../../src/helper/lz4_block.hpp"
 #include "../openvins/openvins_queues.hpp"
 
+#include "generated_config.hpp"
+
+#ifdef ILLIXR_DATASET_PACK
+#include "../../src/dataset_pack.hpp"
+#else
 #include "embedded_cam.hpp"
 
+#ifndef EMBEDDED_CAM_FORMAT
+#error "embedded_cam.hpp predates --cam-format; regenerate it with embed_euroc_data.py"
+#endif
+#endif
+
 using namespace ILLIXR;
 
+#ifdef ILLIXR_DATASET_PACK
+// Frames streamed from the .illixrpack (src/dataset_pack.hpp). Every image
+// is loaded from its chunk and decoded into a slot Mat by the decode workers:
+//   png       → libpng (decode_png)
+//   raw + lz4 → lz4_block_decompress
+//   raw       → copied
+static constexpr bool kZeroCopyFrames  = false;
+static constexpr bool kEqualizedFrames = false;
+
+static bool raw_frames() {
+    return get_dataset_pack().header().cam_encoding ==
+           static_cast<uint32_t>(pack::CamEncoding::raw_gray8);
+}
+
+static size_t frame_count() {
+    const pack::Reader& p = get_dataset_pack();
+    if (!p.ok()) return 0;
+    size_t n0 = p.chunks(pack::Stream::cam0);
+    size_t n1 = p.chunks(pack::Stream::cam1);
+    return n0 < n1 ? n0 : n1;
+}
+
+static int64_t frame_ts_ns(size_t idx) {
+    return get_dataset_pack().chunk(pack::Stream::cam0, idx).first_ts_ns;
+}
+
+static int frame_width()  { return static_cast<int>(get_dataset_pack().header().cam_width); }
+static int frame_height() { return static_cast<int>(get_dataset_pack().header().cam_height); }
+static int frame_stride() { return frame_width(); }
+
+static const char* cam_format_name() {
+    return raw_frames() ? "pack/raw" : "pack/png";
+}
+#else
+// Frame storage chosen by embed_euroc_data.py --cam-format:
+//   png → libpng (decode_png) in the decode workers
+//   lz4 → lz4_block_decompress in the decode workers
+//   raw → no decode at all; CamMsg wraps the ROM arrays directly
+static constexpr bool kZeroCopyFrames  = EMBEDDED_CAM_FORMAT == EMBEDDED_CAM_FORMAT_RAW;
+static constexpr bool kLz4Frames       = EMBEDDED_CAM_FORMAT == EMBEDDED_CAM_FORMAT_LZ4;
+static constexpr bool kEqualizedFrames = kEmbeddedCamEqualized;
+
+static_assert(kEmbeddedCamWidth > 0,
+              "embedded_cam.hpp predates PNG geometry; regenerate it with embed_euroc_data.py");
+
+static size_t  frame_count()           { return kEmbeddedCamCount; }
+static int64_t frame_ts_ns(size_t idx) { return kEmbeddedCam[idx].ts_ns; }
+
+static int frame_width()  { return kEmbeddedCamWidth; }
+static int frame_height() { return kEmbeddedCamHeight; }
+static int frame_stride() { return kEmbeddedCamStride; }
+
+static const char* cam_format_name() {
+    return kZeroCopyFrames ? "raw" : kLz4Frames ? "lz4" : "png";
+}
+#endif
+
 K_THREAD_STACK_DEFINE(offline_cam_stack, 524288);
 
+// ==============================================================================
+// DECODE-AHEAD
+//
+// Two worker threads (one per camera) decode frames into a fixed pool of
+// preallocated Mats. While openvins works on frame N, the workers decode the
+// next CAM_PREFETCH_DEPTH frames the drop policy will send; on SMP the two
+// cameras decode in parallel. The offline_cam thread only schedules slots and
+// waits on their done semaphores. The workers exit on a null slot and are
+// joined when offline_cam stops.
+//
+// The workers make no OpenCV calls: OpenCV is built without thread support
+// (cv::Mutex is a no-op, TLS data is shared), so they must not overlap
+// openvins. PNG goes through OpenCV's bundled libpng directly instead of
+// cv::imdecode, and writes into the slot's existing buffer.
+//
+// A slot's Mats are handed to openvins by reference (no copy) inside the
+// CamMsg. openvins deletes the CamMsg before it gives stoplight_cam again, so
+// the in-flight slot becomes reusable once the next stoplight_cam is taken.
+// ==============================================================================
+
+static constexpr size_t kMaxPrefetchDepth = 8;
+static constexpr size_t kDecodeSlots      = kMaxPrefetchDepth + 1;
+static constexpr size_t kNumCams          = 2;
+
+K_THREAD_STACK_DEFINE(offline_cam_decode0_stack, 262144);
+K_THREAD_STACK_DEFINE(offline_cam_decode1_stack, 262144);
+
+K_MSGQ_DEFINE(offline_cam_decode0_queue, sizeof(void*), kDecodeSlots, 4);
+K_MSGQ_DEFINE(offline_cam_decode1_queue, sizeof(void*), kDecodeSlots, 4);
+
+struct DecodeSlot {
+    size_t      frame_idx;
+    cv::Mat     img[kNumCams];
+    bool        ok[kNumCams];
+    uint64_t    decode_ticks[kNumCams];
+    struct k_sem done[kNumCams];
+#ifdef ILLIXR_DATASET_PACK
+    std::vector<uint8_t> staging[kNumCams];   // chunk bytes read from a filesystem pack
+#endif
+};
+
+// PNG → GRAY8 into dst's buffer (libpng simplified API; no allocation of
+// pixel memory, no OpenCV). Files of another size than the slot fail.
+static bool decode_png(const uint8_t* data, size_t size, cv::Mat& dst) {
+    png_image image;
+    std::memset(&image, 0, sizeof(image));
+    image.version = PNG_IMAGE_VERSION;
+    if (!png_image_begin_read_from_memory(&image, data, size)) return false;
+
+    if (static_cast<int>(image.width) != dst.cols ||
+        static_cast<int>(image.height) != dst.rows) {
+        png_image_free(&image);
+        return false;
+    }
+    image.format = PNG_FORMAT_GRAY;
+    // Frees the image on success and on failure.
+    return png_image_finish_read(&image, nullptr, dst.data,
+                                 static_cast<png_int_32>(dst.step), nullptr) != 0;
+}
+
+#ifdef ILLIXR_DATASET_PACK
+static bool decode_frame(DecodeSlot* slot, size_t cam) {
+    const pack::Reader&     p = get_dataset_pack();
+    const pack::ChunkEntry& e = p.chunk(cam == 0 ? pack::Stream::cam0 : pack::Stream::cam1,
+                                        slot->frame_idx);
+    const uint8_t* data = p.stored(e, slot->staging[cam]);
+    if (!data) return false;
+
+    if (raw_frames()) {
+        // The slot Mat is a continuous width x height buffer.
+        size_t expect = static_cast<size_t>(frame_width()) * frame_height();
+        if (e.raw_size != expect) return false;
+        if (e.codec == static_cast<uint8_t>(pack::Codec::lz4))
+            return lz4_block_decompress(data, e.stored_size, slot->img[cam].data, expect) ==
+                   static_cast<long>(expect);
+        std::memcpy(slot->img[cam].data, data, expect);
+        return true;
+    }
+
+    if (e.codec != static_cast<uint8_t>(pack::Codec::none)) return false;
+    return decode_png(data, e.stored_size, slot->img[cam]);
+}
+#else
+static bool decode_frame(DecodeSlot* slot, size_t cam) {
+    const auto&    frame = kEmbeddedCam[slot->frame_idx];
+    const uint8_t* data  = cam == 0 ? frame.cam0_data : frame.cam1_data;
+    size_t         size  = cam == 0 ? frame.cam0_size : frame.cam1_size;
+
+    if (kLz4Frames) {
+        // The slot Mat views a stride-padded buffer of exactly this size.
+        size_t expect = static_cast<size_t>(kEmbeddedCamStride) * kEmbeddedCamHeight;
+        return lz4_block_decompress(data, size, slot->img[cam].data, expect) ==
+               static_cast<long>(expect);
+    }
+
+    return decode_png(data, size, slot->img[cam]);
+}
+#endif
+
+static void decode_timed(DecodeSlot* slot, size_t cam) {
+    uint64_t t0 = read_mtime();
+    slot->ok[cam]           = decode_frame(slot, cam);
+    slot->decode_ticks[cam] = read_mtime() - t0;
+}
+
+static void decode_worker_entry(void* p1, void* p2, void*) {
+    auto*  queue = static_cast<struct k_msgq*>(p1);
+    size_t cam   = reinterpret_cast<uintptr_t>(p2);
+
+    while (true) {
+        DecodeSlot* slot = nullptr;
+        k_msgq_get(queue, &slot, K_FOREVER);
+        if (!slot) return;   // stop_workers()
+
+        decode_timed(slot, cam);
+        k_sem_give(&slot->done[cam]);
+    }
+}
+
 class Offline_cam : public threadloop {
 public:
     explicit Offline_cam(phonebook_new& pb)
@@ -28,64 +220,326 @@ public:
                      K_THREAD_STACK_SIZEOF(offline_cam_stack),
                      5}
         , current_idx_{0}
+        , sent_{0}
+        , dropped_{0}
+        , stream_ended_{false}
+        , anchor_mtime_{0}
+        , anchor_ts_ns_{0}
     {
-        printf("[offline_cam] constructed  frames=%zu (EuRoC embedded)\n",
-               kEmbeddedCamCount);
+#ifdef ILLIXR_DATASET_PACK
+        printf("[offline_cam] constructed  frames=%zu (EuRoC .illixrpack, %s)  policy=%s\n",
+               frame_count(), cam_format_name(), policy_name());
+#else
+        printf("[offline_cam] constructed  frames=%zu (EuRoC embedded, %s%s)  policy=%s\n",
+               frame_count(), cam_format_name(),
+               kEqualizedFrames ? ", pre-equalized" : "", policy_name());
+#endif
     }
 
     void _p_thread_setup() override {
         printf("[offline_cam] _p_thread_setup() tid=%p\n", k_current_get());
+
+        if (kZeroCopyFrames) {
+            printf("[offline_cam] raw frames %dx%d stride=%d — zero-copy, no decode workers\n",
+                   frame_width(), frame_height(), frame_stride());
+            return;
+        }
+
+        prefetch_depth_ = CAM_DROP_POLICY == CamDropPolicy::skip_to_latest
+                              ? 0
+                              : static_cast<size_t>(CAM_PREFETCH_DEPTH);
+        if (prefetch_depth_ > kMaxPrefetchDepth) prefetch_depth_ = kMaxPrefetchDepth;
+        num_slots_ = prefetch_depth_ + 1;
+
+        for (size_t i = 0; i < num_slots_; i++) {
+            for (size_t c = 0; c < kNumCams; c++) {
+                // Stride-padded buffer, viewed as width x height.
+                cv::Mat padded(frame_height(), frame_stride(), CV_8UC1);
+                slots_[i].img[c] = padded(cv::Rect(0, 0, frame_width(), frame_height()));
+                k_sem_init(&slots_[i].done[c], 0, 1);
+            }
+        }
+
+        start_worker(0, offline_cam_decode0_stack,
+                     K_THREAD_STACK_SIZEOF(offline_cam_decode0_stack),
+                     &offline_cam_decode0_queue, "offline_cam_dec0");
+        start_worker(1, offline_cam_decode1_stack,
+                     K_THREAD_STACK_SIZEOF(offline_cam_decode1_stack),
+                     &offline_cam_decode1_queue, "offline_cam_dec1");
+        workers_started_ = true;
+
+        printf("[offline_cam] decode-ahead depth=%zu  slots=%zu  img=%dx%d  format=%s\n",
+               prefetch_depth_, num_slots_, frame_width(), frame_height(), cam_format_name());
     }
 
     skip_option _p_should_skip() override {
-        if (current_idx_ >= kEmbeddedCamCount)
+        if (stream_ended_)
             return skip_option::stop;
         return skip_option::run;
     }
 
-    void _p_one_iteration() override {
-        k_sem_take(&stoplight_cam, K_FOREVER);
+    void stop() override {
+        threadloop::stop();
+        // Wake the thread if it waits for openvins; it joins the workers.
+        k_sem_give(&stoplight_cam);
+    }
 
-        const auto& frame = kEmbeddedCam[current_idx_];
+    void _p_one_iteration() override {
+        audit_sem_take(&stoplight_cam, K_FOREVER, "stoplight_cam");
+        if (!should_terminate()) send_next_frame();
 
-        // Wrap raw PNG bytes in a cv::Mat (no copy), then decode
-        cv::Mat png0_buf(1, (int)frame.cam0_size, CV_8UC1,
-                         const_cast<uint8_t*>(frame.cam0_png));
-        cv::Mat png1_buf(1, (int)frame.cam1_size, CV_8UC1,
-                         const_cast<uint8_t*>(frame.cam1_png));
+        // The loop exits without calling back once stopped (end of stream
+        // or stop()). Only this thread schedules the workers, so it also
+        // joins them.
+        if (stream_ended_ || should_terminate()) stop_workers();
+    }
 
-        cv::Mat img0 = cv::imdecode(png0_buf, cv::IMREAD_GRAYSCALE);
-        cv::Mat img1 = cv::imdecode(png1_buf, cv::IMREAD_GRAYSCALE);
+private:
+    void send_next_frame() {
+        // openvins is done with the previous frame → its slot is free again.
+        in_flight_ = false;
 
-        if (img0.empty() || img1.empty()) {
-            printf("[offline_cam] ERROR: imdecode failed frame %zu\n", current_idx_);
-            k_sem_give(&stoplight_cam);
-            ++current_idx_;
+        // Frames skipped by the drop policy are dropped here, before they
+        // cost a decode. The IMU side is unaffected: openvins still requests
+        // every sample up to the timestamp of the frame it does get.
+        size_t next = select_next_frame();
+        discard_scheduled_before(next);
+        drop_until(next);
+        if (current_idx_ >= frame_count()) {
+            end_stream();
             return;
         }
 
+        int64_t ts_ns = frame_ts_ns(current_idx_);
+        cv::Mat img0, img1;
+
+        if (kZeroCopyFrames) {
+#ifndef ILLIXR_DATASET_PACK
+            img0 = rom_view(kEmbeddedCam[current_idx_].cam0_data);
+            img1 = rom_view(kEmbeddedCam[current_idx_].cam1_data);
+#endif
+        } else {
+            DecodeSlot& slot = take_decoded();
+
+            if (!slot.ok[0] || !slot.ok[1]) {
+                printf("[offline_cam] ERROR: %s decode failed frame %zu\n",
+                       cam_format_name(), current_idx_);
+                audit_sem_give(&stoplight_cam, "stoplight_cam");
+                ++current_idx_;
+                return;
+            }
+            decode_ticks_   += slot.decode_ticks[0] + slot.decode_ticks[1];
+            decoded_images_ += kNumCams;
+
+            // Keep the workers busy on the frames after this one while openvins
+            // processes it.
+            in_flight_ = true;
+            prefetch_after(current_idx_);
+
+            img0 = slot.img[0];
+            img1 = slot.img[1];
+        }
+
         CamMsg* msg = new CamMsg{
-            ILLIXR::time_point{std::chrono::nanoseconds{frame.ts_ns}},
+            ILLIXR::time_point{std::chrono::nanoseconds{ts_ns}},
             img0,
-            img1
+            img1,
+            Provenance{ts_ns, read_mtime(), static_cast<uint32_t>(current_idx_)},
+            kEqualizedFrames
         };
 
-        int rc = k_msgq_put(&openvins_cam_queue, &msg, K_NO_WAIT);
+        int rc = audit_msgq_put(&openvins_cam_queue, &msg, K_NO_WAIT, "openvins_cam_queue");
         
         if (rc != 0) {
             delete msg;
             printf("[offline_cam] ERROR: queue put failed rc=%d\n", rc);
+        } else {
+            ++sent_;
+        }
+
+        if (anchor_mtime_ == 0) {
+            anchor_mtime_ = read_mtime();
+            anchor_ts_ns_ = ts_ns;
         }
 
         printf("[offline_cam] SENT frame #%03zu  ts=%lld ns  img=%dx%d\n",
-               current_idx_, (long long)frame.ts_ns,
+               current_idx_, (long long)ts_ns,
                img0.cols, img0.rows);
 
         ++current_idx_;
     }
 
-private:
-    size_t current_idx_;
+    size_t   current_idx_;
+    size_t   sent_;
+    size_t   dropped_;
+    bool     stream_ended_;
+
+    // skip_to_latest: wall clock ↔ dataset clock, fixed at the first frame sent
+    uint64_t anchor_mtime_;
+    int64_t  anchor_ts_ns_;
+
+    // Decode-ahead ring: slots_[head_ .. head_+scheduled_) are queued or
+    // decoded in frame order; the slot just before head_ is with openvins
+    // while in_flight_ is set.
+    DecodeSlot      slots_[kDecodeSlots];
+    size_t          num_slots_      = 1;
+    size_t          prefetch_depth_ = 0;
+    size_t          head_           = 0;
+    size_t          scheduled_      = 0;
+    bool            in_flight_      = false;
+    struct k_thread workers_[kNumCams];
+    bool            workers_started_ = false;
+    uint64_t        decode_ticks_   = 0;   // summed over both cameras
+    size_t          decoded_images_ = 0;
+
+    // Read-only view of a raw frame in ROM; openvins never writes its input.
+    static cv::Mat rom_view(const uint8_t* data) {
+        return cv::Mat(frame_height(), frame_width(), CV_8UC1,
+                       const_cast<uint8_t*>(data), frame_stride());
+    }
+
+    void start_worker(size_t cam, k_thread_stack_t* stack, size_t stack_size,
+                      struct k_msgq* queue, const char* name) {
+        k_tid_t tid = k_thread_create(&workers_[cam], stack, stack_size,
+                                      decode_worker_entry,
+                                      queue, reinterpret_cast<void*>(cam), nullptr,
+                                      K_PRIO_PREEMPT(5), 0, K_NO_WAIT);
+        if (tid) k_thread_name_set(tid, name);
+    }
+
+    // Queued slots are decoded before the null slot that ends each worker.
+    void stop_workers() {
+        if (!workers_started_) return;
+        DecodeSlot* none = nullptr;
+        k_msgq_put(&offline_cam_decode0_queue, &none, K_FOREVER);
+        k_msgq_put(&offline_cam_decode1_queue, &none, K_FOREVER);
+        for (size_t c = 0; c < kNumCams; c++) k_thread_join(&workers_[c], K_FOREVER);
+        workers_started_ = false;
+        printf("[offline_cam] decode workers joined\n");
+    }
+
+    // Next frame from the decode-ahead ring, scheduling it if it is not.
+    DecodeSlot& take_decoded() {
+        if (scheduled_ == 0) schedule(current_idx_);
+
+        DecodeSlot& slot = slots_[head_];
+        wait_decoded(slot);
+        head_ = (head_ + 1) % num_slots_;
+        --scheduled_;
+        return slot;
+    }
+
+    void schedule(size_t frame_idx) {
+        DecodeSlot* slot = &slots_[(head_ + scheduled_) % num_slots_];
+        slot->frame_idx  = frame_idx;
+        k_msgq_put(&offline_cam_decode0_queue, &slot, K_FOREVER);
+        k_msgq_put(&offline_cam_decode1_queue, &slot, K_FOREVER);
+        ++scheduled_;
+    }
+
+    void wait_decoded(DecodeSlot& slot) {
+        k_sem_take(&slot.done[0], K_FOREVER);
+        k_sem_take(&slot.done[1], K_FOREVER);
+    }
+
+    // Prefetched frames the policy has since skipped (or any mismatch with
+    // the prediction) are waited out and recycled.
+    void discard_scheduled_before(size_t next) {
+        while (scheduled_ > 0 && slots_[head_].frame_idx != next) {
+            wait_decoded(slots_[head_]);
+            head_ = (head_ + 1) % num_slots_;
+            --scheduled_;
+        }
+    }
+
+    // Fill the free slots with the frames the policy will ask for next.
+    void prefetch_after(size_t frame_idx) {
+        if (prefetch_depth_ == 0) return;
+
+        size_t last = frame_idx;
+        if (scheduled_ > 0)
+            last = slots_[(head_ + scheduled_ - 1) % num_slots_].frame_idx;
+
+        size_t free_slots = num_slots_ - scheduled_ - (in_flight_ ? 1 : 0);
+        while (free_slots-- > 0) {
+            size_t n = predict_after(last);
+            if (n >= frame_count()) break;
+            schedule(n);
+            last = n;
+        }
+    }
+
+    // Frame the policy sends after frame_idx (strict / decimate only).
+    static size_t predict_after(size_t frame_idx) {
+        if (CAM_DROP_POLICY == CamDropPolicy::decimate) {
+            size_t n = static_cast<size_t>(CAM_DECIMATE_N);
+            return (frame_idx / n + 1) * n;
+        }
+        return frame_idx + 1;
+    }
+
+    static const char* policy_name() {
+        switch (CAM_DROP_POLICY) {
+        case CamDropPolicy::strict:         return "strict";
+        case CamDropPolicy::skip_to_latest: return "skip_to_latest";
+        case CamDropPolicy::decimate:       return "decimate";
+        }
+        return "?";
+    }
+
+    // Index of the frame to send for this request (>= current_idx_).
+    size_t select_next_frame() const {
+        size_t next = current_idx_;
+        switch (CAM_DROP_POLICY) {
+        case CamDropPolicy::strict:
+            break;
+
+        case CamDropPolicy::decimate: {
+            // Frames 0, N, 2N, ...
+            size_t n = static_cast<size_t>(CAM_DECIMATE_N);
+            next = (current_idx_ + n - 1) / n * n;
+            break;
+        }
+
+        case CamDropPolicy::skip_to_latest: {
+            // Newest frame the camera would have produced by now, with the
+            // dataset replayed at CAM_TIME_SCALE x wall time.
+            if (anchor_mtime_ == 0) break;
+            double  wall_s    = static_cast<double>(read_mtime() - anchor_mtime_) /
+                                static_cast<double>(kMtimeHz);
+            int64_t latest_ns = anchor_ts_ns_ +
+                                static_cast<int64_t>(wall_s * CAM_TIME_SCALE * 1e9);
+            while (next + 1 < frame_count() && frame_ts_ns(next + 1) <= latest_ns)
+                ++next;
+            break;
+        }
+        }
+        return next < frame_count() ? next : frame_count();
+    }
+
+    void drop_until(size_t next) {
+        for (; current_idx_ < next; ++current_idx_) {
+            ++dropped_;
+            printf("[offline_cam] DROP frame #%03zu  ts=%lld ns  (policy=%s)\n",
+                   current_idx_, (long long)frame_ts_ns(current_idx_),
+                   policy_name());
+        }
+    }
+
+    // Tell openvins there are no more frames instead of leaving it blocked
+    // on the queue.
+    void end_stream() {
+        CamMsg* end_marker = nullptr;
+        audit_msgq_put(&openvins_cam_queue, &end_marker, K_FOREVER, "openvins_cam_queue");
+        stream_ended_ = true;
+        printf("[offline_cam] end of stream  sent=%zu dropped=%zu of %zu frames  (policy=%s)\n",
+               sent_, dropped_, frame_count(), policy_name());
+        double decode_us = decoded_images_
+            ? static_cast<double>(decode_ticks_) * 1e6 / kMtimeHz / decoded_images_
+            : 0.0;
+        printf("[offline_cam] decode  format=%s  avg=%.1f us/image over %zu images\n",
+               cam_format_name(), decode_us, decoded_images_);
+    }
 };
 
 void start_offline_cam(phonebook_new& pb) {
@@ -64,8 +64,9 @@ static std::map<ullong, sensor_types> load_data() {
 
 #pragma once
 #include <cstdint>
-#include <cstdint>
-#include <map>
+#include <cstdio>
+
+#include "../../src/helper/time_series.hpp"
 
 namespace ILLIXR {
 // 1. Define the structure for a single data point (row)
@@ -108,47 +109,21 @@ DataPoint sensorData[DATA_SIZE] = {
     {1403715524022142976, -0.0027925268031909274, 0.016755160819145562, 0.078888882190143686, 9.242767624999999, 0.30237170833333332, -3.2035056666666666}
 };
 
-typedef struct {
-    Eigen::Vector3d angular_v;
-    Eigen::Vector3d linear_a;
-} raw_imu_type;
-
-typedef struct {
-    raw_imu_type imu0;
-} sensor_types;
+// Channels: angular velocity x/y/z (rad/s), then linear acceleration x/y/z (m/s^2).
+typedef TimeSeries<6, double> sensor_types;
 
+static sensor_types load_data() {
+    sensor_types data;
+    data.reserve(DATA_SIZE);
 
-static std::map<ullong, sensor_types> load_data() {
-    std::map<ullong, sensor_types> data;
-    
-    // Iterate through the hardcoded array instead of reading from a file
+    // The hardcoded array is already in timestamp order.
     for (size_t i = 0; i < DATA_SIZE; ++i) {
-        
-        // 1. Extract the timestamp and cast it to ullong (unsigned long long)
-        ullong t = static_cast<ullong>(sensorData[i].timestamp);
-        
-        // 2. Load the Angular Velocity (col1, col2, col3) into Eigen::Vector3d
-        Eigen::Vector3d av{
-            sensorData[i].col1,
-            sensorData[i].col2,
-            sensorData[i].col3
-        };
-        
-        // 3. Load the Linear Acceleration (col4, col5, col6) into Eigen::Vector3d
-        Eigen::Vector3d la{
-            sensorData[i].col4,
-            sensorData[i].col5,
-            sensorData[i].col6
-        };
-        
-        // 4. Populate the map using the defined structs:
-        //    data[t].imu0 is a raw_imu_type, which is initialized with {av, la}.
-        data[t].imu0 = {av, la}; 
+        const DataPoint& p = sensorData[i];
+        data.push_back(static_cast<uint64_t>(p.timestamp), {p.col1, p.col2, p.col3, p.col4, p.col5, p.col6});
     }
-    
-    // Log the loaded count (using printf as a substitute for printk/spdlog)
+
     printf("[offline_imu] Loaded %u IMU samples\n", (unsigned int)data.size());
-    
+
     return data;
 }
 } // namespace ILLIXR
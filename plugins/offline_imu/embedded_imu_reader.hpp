@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "embedded_imu.hpp"
+
+// ==============================================================================
+// EMBEDDED IMU READER
+//
+// Sequential cursor over embedded_imu.hpp, whichever layout
+// embed_euroc_data.py --imu-format produced:
+//   aos : kEmbeddedImu[] structs (int64 ts + 6 doubles)
+//   f32 : SoA, delta timestamps + float channels
+//   i16 : SoA, delta timestamps + int16 channels × kEmbeddedImuScale
+//
+// The SoA layouts only store timestamp deltas, so the cursor keeps a running
+// absolute timestamp and only moves forward. offline_imu streams samples in
+// order, so that is all it needs.
+// ==============================================================================
+
+#ifndef EMBEDDED_IMU_FORMAT
+// Headers generated before --imu-format existed are always AoS.
+#define EMBEDDED_IMU_FORMAT_AOS 0
+#define EMBEDDED_IMU_FORMAT     EMBEDDED_IMU_FORMAT_AOS
+#endif
+
+class EmbeddedImuReader {
+public:
+    EmbeddedImuReader() : idx_{0}, ts_ns_{first_ts_ns()} { }
+
+    static constexpr size_t size() { return kEmbeddedImuCount; }
+
+    bool    done()  const { return idx_ >= kEmbeddedImuCount; }
+    size_t  index() const { return idx_; }
+    int64_t ts_ns() const { return ts_ns_; }
+
+    static int64_t first_ts_ns() {
+        if (kEmbeddedImuCount == 0) return 0;
+#if EMBEDDED_IMU_FORMAT == EMBEDDED_IMU_FORMAT_AOS
+        return kEmbeddedImu[0].ts_ns;
+#else
+        return kEmbeddedImuT0Ns;
+#endif
+    }
+
+    // Current sample: gyro (rad/s) and accel (m/s^2).
+    void read(double w[3], double a[3]) const {
+#if EMBEDDED_IMU_FORMAT == EMBEDDED_IMU_FORMAT_AOS
+        const auto& s = kEmbeddedImu[idx_];
+        w[0] = s.wx; w[1] = s.wy; w[2] = s.wz;
+        a[0] = s.ax; a[1] = s.ay; a[2] = s.az;
+#elif EMBEDDED_IMU_FORMAT == EMBEDDED_IMU_FORMAT_F32
+        for (int c = 0; c < 3; c++) {
+            w[c] = kEmbeddedImuChannel[c][idx_];
+            a[c] = kEmbeddedImuChannel[3 + c][idx_];
+        }
+#else
+        for (int c = 0; c < 3; c++) {
+            w[c] = kEmbeddedImuChannel[c][idx_]     * static_cast<double>(kEmbeddedImuScale[c]);
+            a[c] = kEmbeddedImuChannel[3 + c][idx_] * static_cast<double>(kEmbeddedImuScale[3 + c]);
+        }
+#endif
+    }
+
+    void advance() {
+        ++idx_;
+        if (done()) return;
+#if EMBEDDED_IMU_FORMAT == EMBEDDED_IMU_FORMAT_AOS
+        ts_ns_ = kEmbeddedImu[idx_].ts_ns;
+#else
+        ts_ns_ += kEmbeddedImuDtNs[idx_];
+#endif
+    }
+
+private:
+    size_t  idx_;
+    int64_t ts_ns_;
+};
@@ -8,26 +8,23 @@
 #include "../../src/plugin_registry.hpp"
 #include "../../src/data_format.hpp"
 #include "../../src/stoplight.hpp"
+#include "../../src/mtime.hpp"
+#include "../../src/lock_audit.hpp"
 #include "../openvins/openvins_queues.hpp"
 #include "../imu_integrator/imu_integrator_queue.hpp"
 
-#include "embedded_imu.hpp"
+#ifdef ILLIXR_DATASET_PACK
+#include "../../src/dataset_pack.hpp"
+#else
+#include "embedded_imu_reader.hpp"
+#endif
 
 using namespace ILLIXR;
 
 extern uint64_t g_program_start_mtime;
 
-// CLINT mtime: global real-time counter, consistent across all harts
-static inline uint64_t read_mtime() {
-    volatile uint64_t* mtime = reinterpret_cast<volatile uint64_t*>(0x200bff8UL);
-    return *mtime;
-}
-
 K_THREAD_STACK_DEFINE(offline_imu_stack, 262144);
 
-// Window size must match what openvins expects
-static constexpr size_t kSamplesPerWindow = 10;
-
 class Offline_imu : public threadloop {
 public:
     explicit Offline_imu(phonebook_new& pb)
@@ -35,53 +32,82 @@ public:
                      offline_imu_stack,
                      K_THREAD_STACK_SIZEOF(offline_imu_stack),
                      5}
-        , current_idx_{0}
+#ifdef ILLIXR_DATASET_PACK
+        , reader_{get_dataset_pack()}
     {
-        printf("[offline_imu] constructed  samples=%zu (EuRoC embedded)\n",
-               kEmbeddedImuCount);
+        printf("[offline_imu] constructed  samples=%zu (EuRoC .illixrpack)\n", reader_.size());
     }
-
-    skip_option _p_should_skip() override {
-        if (current_idx_ >= kEmbeddedImuCount)
-            return skip_option::stop;
-        return skip_option::run;
+#else
+    {
+        printf("[offline_imu] constructed  samples=%zu (EuRoC embedded, layout %d)\n",
+               reader_.size(), EMBEDDED_IMU_FORMAT);
     }
+#endif
 
+    // One iteration answers one "all IMU up to t" request from openvins.
+    // The thread stays alive after the data runs out so later requests still
+    // get an end marker instead of leaving openvins blocked on the queue.
     void _p_one_iteration() override {
-        size_t pos_in_window = current_idx_ % kSamplesPerWindow;
+        audit_sem_take(&stoplight_imu, K_FOREVER, "stoplight_imu");
+
+        int64_t until_ns = static_cast<int64_t>(atomic_get(&imu_request_until_ns));
+        printf("[Offline_imu] Green light received, sending from #%zu up to t=%lld ns\n",
+               reader_.index(), (long long)until_ns);
+
+        bool covered = false;
+        while (!covered && !reader_.done()) {
+            covered = reader_.ts_ns() >= until_ns;
+            send_sample();
+        }
 
-        if (pos_in_window == 0) {
-            k_sem_take(&stoplight_imu, K_FOREVER);
-            printf("[Offline_imu] Green light received, sending window starting at #%zu\n",
-                   current_idx_);
+        if (!covered) {
+            ImuMsg* end_marker = nullptr;
+            audit_msgq_put(&openvins_imu_queue, &end_marker, K_FOREVER, "openvins_imu_queue");
+            printf("[offline_imu] end of IMU data at #%zu — sent end marker\n", reader_.index());
         }
+        k_yield();
+    }
 
-        const auto& s = kEmbeddedImu[current_idx_];
+private:
+#ifdef ILLIXR_DATASET_PACK
+    pack::ImuCursor   reader_;
+#else
+    EmbeddedImuReader reader_;
+#endif
+
+    void send_sample() {
+        size_t  idx   = reader_.index();
+        int64_t ts_ns = reader_.ts_ns();
+        double  w[3], a[3];
+        reader_.read(w, a);
 
         ImuMsg* msg_vins = new ImuMsg{
-            time_point{std::chrono::nanoseconds{s.ts_ns}},
-            Eigen::Vector3d{s.wx, s.wy, s.wz},
-            Eigen::Vector3d{s.ax, s.ay, s.az}
+            time_point{std::chrono::nanoseconds{ts_ns}},
+            Eigen::Vector3d{w[0], w[1], w[2]},
+            Eigen::Vector3d{a[0], a[1], a[2]},
+            Provenance{ts_ns, read_mtime(), static_cast<uint32_t>(idx)}
         };
         ImuMsg* msg_int = new ImuMsg{*msg_vins};  // copy
 
-        int rc1 = k_msgq_put(&openvins_imu_queue,     &msg_vins, K_NO_WAIT);
-        int rc2 = k_msgq_put(&imu_integrator_queue,   &msg_int,  K_NO_WAIT);
+        // Openvins drains its queue while a request is in flight, so a request
+        // larger than the queue depth just waits here instead of failing.
+        int rc1 = audit_msgq_put(&openvins_imu_queue,   &msg_vins, K_FOREVER, "openvins_imu_queue");
+        int rc2 = audit_msgq_put(&imu_integrator_queue, &msg_int,  K_NO_WAIT, "imu_integrator_queue");
 
-        if (rc1 != 0) { delete msg_vins; printf("[offline_imu] ERROR: openvins queue full\n"); }
+        if (rc1 != 0) { delete msg_vins; printf("[offline_imu] ERROR: openvins queue put failed rc=%d\n", rc1); }
         if (rc2 != 0) { delete msg_int;  printf("[offline_imu] ERROR: integrator queue full\n"); }
         printf("[offline_imu] IMU #%04zu ts=%lld ns\n",
-               current_idx_ + 1, (long long)s.ts_ns);
+               idx + 1, (long long)ts_ns);
 
-        ++current_idx_;
+        reader_.advance();
 
-        if (current_idx_ == 50) {
+        if (reader_.index() == 50) {
             uint64_t end_mtime  = read_mtime();
             uint64_t elapsed    = end_mtime - g_program_start_mtime;
             // CLINT mtime ticks at the CPU reference clock (10 MHz on Spike by default)
             // elapsed / 10_000_000 = wall seconds
-            double   elapsed_s  = static_cast<double>(elapsed) / 10000000.0;
-            double   imu_span_s = static_cast<double>(s.ts_ns - kEmbeddedImu[0].ts_ns) * 1e-9;
+            double   elapsed_s  = static_cast<double>(elapsed) / static_cast<double>(kMtimeHz);
+            double   imu_span_s = static_cast<double>(ts_ns - reader_.first_ts_ns()) * 1e-9;
             printf("\n[MTIME_COUNT] 50 IMU samples processed (global CLINT mtime)\n");
             printf("[MTIME_COUNT]   start  mtime  : %llu ticks\n", (unsigned long long)g_program_start_mtime);
             printf("[MTIME_COUNT]   end    mtime  : %llu ticks\n", (unsigned long long)end_mtime);
@@ -90,11 +116,7 @@ public:
             printf("[MTIME_COUNT]   IMU data span : %.6f s\n", imu_span_s);
             printf("[MTIME_COUNT]   slowdown ratio: %.2fx real-time\n\n", elapsed_s / imu_span_s);
         }
-        k_yield();
     }
-
-private:
-    size_t current_idx_;
 };
 
 void start_offline_imu(phonebook_new& pb) {
@@ -1,4 +1,5 @@
 #include "SLAMMath.hpp"
+#include "../../src/mtime.hpp"
 
 namespace OpenVINS {
 
@@ -158,135 +159,217 @@ double MSCKFEstimator::epipolar_distance(const cv::Point2f& p0,
     return (den > 1e-10) ? std::abs(num) / std::sqrt(den) : 1e9;
 }
 
-void MSCKFEstimator::track_features(double timestamp, const cv::Mat& img0, const cv::Mat& img1) {
+void MSCKFEstimator::track_features(const cv::Mat& img0, const cv::Mat& img1,
+                                    bool pre_equalized) {
+    frame_++;
 
     // Histogram equalization — normalises contrast so NCC scores are stable
     // across illumination changes (mirrors what reference TrackKLT does).
+    // Frames embedded with --equalize already went through the same LUT.
     cv::Mat img0e, img1e;
-    cv::equalizeHist(img0, img0e);
-    cv::equalizeHist(img1, img1e);
+    if (pre_equalized) {
+        img0e = img0;
+        img1e = img1;
+    } else {
+        cv::equalizeHist(img0, img0e);
+        cv::equalizeHist(img1, img1e);
+    }
+
+    if (config_.rectify_stereo) {
+        // Everything below, temporal tracking included, sees the rectified
+        // pair; lut0_/lut1_ map its pixels to each camera's normalised frame.
+        lut0_.remap(img0e, rect0_);
+        lut1_.remap(img1e, rect1_);
+        img0e = rect0_;
+        img1e = rect1_;
+    }
+
+    if (config_.tracker != VIOConfig::Tracker::box) {
+        curr_pyr0_.build(img0e, config_.pyramid_levels);
+        curr_pyr1_.build(img1e, config_.pyramid_levels);
+    }
 
     if (prev_img0_.empty()) {
         // ── First frame: detect corners in cam0, stereo-match into cam1 ──────
-        std::vector<cv::Point2f> corners0;
-        cv::goodFeaturesToTrack(img0e, corners0,
-                                config_.max_features,
-                                0.01,   // qualityLevel
-                                10.0);  // minDistance
-
-        for (const auto& c0 : corners0) {
-            cv::Point2f c1;
-            bool found = track_stereo_epipolar(img0e, img1e, c0, c1,
-                                               F_stereo_,
-                                               config_.template_size,
-                                               config_.stereo_search_radius,
-                                               config_.match_threshold);
-            if (!found) continue;
-
-            Feature feat;
-            feat.id = feature_id_counter_++;
-            feat.observations[timestamp] = {
-                undistort_point(Eigen::Vector2d(c0.x, c0.y), config_.cam0),
-                undistort_point(Eigen::Vector2d(c1.x, c1.y), config_.cam1)
-            };
-            feature_tracks_[feat.id] = feat;
-        }
-
-        prev_img0_ = img0e.clone();
-        prev_img1_ = img1e.clone();
+        detect_features(img0e, img1e, 0);
+        keep_as_previous(img0e, img1e);
         return;
     }
 
     // ── Subsequent frames: track forward in both cameras ─────────────────────
-    for (auto& kv : feature_tracks_) {
-        Feature& feat = kv.second;
-        if (feat.observations.empty()) continue;
+    Eigen::Matrix3d R_C0, R_C1;   // previous → current camera rotation
+    bool predict = config_.imu_predict_search && predict_rotation(R_C0, R_C1);
 
-        const auto& last_obs = feat.observations.rbegin()->second;
+    // Every live track was seen in the previous frame (remove_lost).
+    for (size_t i = 0; i < features_.size(); i++) {
+        const Eigen::Vector2d& last0 = features_.uv0(i, features_.last(i));
+        const Eigen::Vector2d& last1 = features_.uv1(i, features_.last(i));
 
-        // Normalised undistorted → distorted pixel via full projection.
-        Eigen::Vector2d px0 = project_point(
-            Eigen::Vector3d(last_obs.first(0),  last_obs.first(1),  1.0), config_.cam0);
-        Eigen::Vector2d px1 = project_point(
-            Eigen::Vector3d(last_obs.second(0), last_obs.second(1), 1.0), config_.cam1);
+        // Normalised undistorted → distorted pixel via the distortion table.
+        Eigen::Vector2d px0 = lut0_.distort(last0);
+        Eigen::Vector2d px1 = lut1_.distort(last1);
         double x0 = px0(0), y0 = px0(1);
         double x1 = px1(0), y1 = px1(1);
 
         cv::Point2f prev0(x0, y0), prev1(x1, y1), curr0, curr1;
 
-        bool ok0 = track_point_template(prev_img0_, img0e, prev0, curr0,
-                                        config_.template_size, config_.search_radius,
-                                        config_.match_threshold);
-        bool ok1 = track_point_template(prev_img1_, img1e, prev1, curr1,
-                                        config_.template_size, config_.search_radius,
-                                        config_.match_threshold);
+        // Where the rotation alone moves the feature; a bearing rotated
+        // behind a camera keeps the full-radius search at the old position.
+        cv::Point2f pred0 = prev0, pred1 = prev1;
+        bool pred_ok = predict &&
+                       rotate_to_pixel(R_C0, last0, lut0_, pred0) &&
+                       rotate_to_pixel(R_C1, last1, lut1_, pred1);
+        if (!pred_ok) { pred0 = prev0; pred1 = prev1; }
+
+        bool ok0 = track_temporal(prev_img0_, prev_pyr0_, img0e, curr_pyr0_,
+                                  prev0, pred0, pred_ok, curr0);
+        bool ok1 = track_temporal(prev_img1_, prev_pyr1_, img1e, curr_pyr1_,
+                                  prev1, pred1, pred_ok, curr1);
 
+        track_stats_.attempted++;
         if (!ok0 || !ok1) continue;
 
         // ── Forward-backward consistency check ────────────────────────────────
         // Track curr→prev and reject if round-trip error exceeds threshold.
         // Catches NCC false positives without needing cv::calib3d/RANSAC.
-        cv::Point2f back0, back1;
-        bool fb0 = track_point_template(img0e, prev_img0_, curr0, back0,
-                                        config_.template_size, config_.search_radius,
-                                        config_.match_threshold);
-        bool fb1 = track_point_template(img1e, prev_img1_, curr1, back1,
-                                        config_.template_size, config_.search_radius,
-                                        config_.match_threshold);
+        // With a prediction, the way back is centred on the match rotated
+        // back, which is where the old position lies for a correct match.
+        cv::Point2f back0, back1, bpred0 = curr0, bpred1 = curr1;
+        if (pred_ok) {
+            rotate_to_pixel(R_C0.transpose(),
+                            lut0_.undistort(Eigen::Vector2d(curr0.x, curr0.y)),
+                            lut0_, bpred0);
+            rotate_to_pixel(R_C1.transpose(),
+                            lut1_.undistort(Eigen::Vector2d(curr1.x, curr1.y)),
+                            lut1_, bpred1);
+        }
+        bool fb0 = track_temporal(img0e, curr_pyr0_, prev_img0_, prev_pyr0_,
+                                  curr0, bpred0, pred_ok, back0);
+        bool fb1 = track_temporal(img1e, curr_pyr1_, prev_img1_, prev_pyr1_,
+                                  curr1, bpred1, pred_ok, back1);
 
         float err0 = std::hypot(back0.x - prev0.x, back0.y - prev0.y);
         float err1 = std::hypot(back1.x - prev1.x, back1.y - prev1.y);
         if (!fb0 || !fb1 || err0 > config_.fb_check_thresh || err1 > config_.fb_check_thresh)
             continue;
+        track_stats_.tracked++;
 
-        feat.observations[timestamp] = {
-            undistort_point(Eigen::Vector2d(curr0.x, curr0.y), config_.cam0),
-            undistort_point(Eigen::Vector2d(curr1.x, curr1.y), config_.cam1)
-        };
+        features_.observe(i, frame_,
+                          lut0_.undistort(Eigen::Vector2d(curr0.x, curr0.y)),
+                          lut1_.undistort(Eigen::Vector2d(curr1.x, curr1.y)));
     }
 
     // ── Re-detect new features when tracked count falls below min_features ────
     int active = 0;
-    for (const auto& kv : feature_tracks_)
-        if (kv.second.observations.count(timestamp)) active++;
-
-    if (active < config_.min_features) {
-        // Mask out existing tracked feature locations
-        cv::Mat mask = cv::Mat::ones(img0.size(), CV_8UC1) * 255;
-        for (const auto& kv : feature_tracks_) {
-            if (!kv.second.observations.count(timestamp)) continue;
-            const auto& obs = kv.second.observations.rbegin()->second;
-            Eigen::Vector2d mpx = project_point(
-                Eigen::Vector3d(obs.first(0), obs.first(1), 1.0), config_.cam0);
-            int px = static_cast<int>(mpx(0));
-            int py = static_cast<int>(mpx(1));
-            cv::circle(mask, cv::Point(px, py), 10, cv::Scalar(0), -1);
-        }
+    for (size_t i = 0; i < features_.size(); i++)
+        if (features_.last(i) == frame_) active++;
 
-        std::vector<cv::Point2f> new_corners;
-        cv::goodFeaturesToTrack(img0e, new_corners,
-                                config_.max_features - active,
-                                0.01, 10.0, mask);
-
-        for (const auto& c0 : new_corners) {
-            cv::Point2f c1;
-            if (!track_stereo_epipolar(img0e, img1e, c0, c1,
-                                      F_stereo_,
-                                      config_.template_size,
-                                      config_.stereo_search_radius,
-                                      config_.match_threshold)) continue;
-            Feature feat;
-            feat.id = feature_id_counter_++;
-            feat.observations[timestamp] = {
-                undistort_point(Eigen::Vector2d(c0.x, c0.y), config_.cam0),
-                undistort_point(Eigen::Vector2d(c1.x, c1.y), config_.cam1)
-            };
-            feature_tracks_[feat.id] = feat;
-        }
+    if (active < config_.min_features)
+        detect_features(img0e, img1e, active);
+
+    keep_as_previous(img0e, img1e);
+}
+
+// New cam0 corners up to max_features, away from the `active` features
+// tracked into this frame, each stereo-matched into cam1 to start a track.
+void MSCKFEstimator::detect_features(const cv::Mat& img0e, const cv::Mat& img1e, int active) {
+    detector_.reset(img0e.cols, img0e.rows, config_.detect_grid_cols, config_.detect_grid_rows,
+                    config_.max_features, config_.min_feature_distance,
+                    config_.template_size / 2);
+    for (size_t i = 0; i < features_.size(); i++) {
+        if (features_.last(i) != frame_) continue;
+        Eigen::Vector2d mpx = lut0_.distort(features_.uv0(i, frame_));
+        detector_.occupy(static_cast<float>(mpx(0)), static_cast<float>(mpx(1)));
+    }
+
+    std::vector<Corner> corners;
+    detector_.detect(gray_view(img0e), config_.fast_threshold,
+                     config_.max_features - active, corners);
+
+    for (const Corner& c : corners) {
+        cv::Point2f c0(c.x, c.y), c1;
+        bool found = config_.rectify_stereo
+            ? track_stereo_row(ncc_, img0e, img1e, c0, c1,
+                               config_.template_size,
+                               config_.stereo_search_radius,
+                               config_.match_threshold,
+                               config_.subpixel)
+            : track_stereo_epipolar(ncc_, img0e, img1e, c0, c1,
+                                    F_stereo_,
+                                    config_.template_size,
+                                    config_.stereo_search_radius,
+                                    config_.match_threshold,
+                                    config_.subpixel);
+        if (!found) continue;
+        features_.add(feature_id_counter_++, frame_,
+                      lut0_.undistort(Eigen::Vector2d(c0.x, c0.y)),
+                      lut1_.undistort(Eigen::Vector2d(c1.x, c1.y)));
     }
+}
+
+// Drops the tracks not found in this frame. Indices are visited from the
+// back, so the feature remove() moves into a hole has been checked already.
+void MSCKFEstimator::remove_lost() {
+    for (size_t i = features_.size(); i-- > 0; )
+        if (features_.last(i) != frame_) features_.remove(i);
+}
 
+// Rotation of each camera from the previous frame to now: the previous
+// frame's clone against the IMU state propagated up to this frame. False
+// before the filter runs, or when the previous frame has no clone (the
+// frame that initialised the filter).
+bool MSCKFEstimator::predict_rotation(Eigen::Matrix3d& R_C0, Eigen::Matrix3d& R_C1) const {
+    if (!initialized_) return false;
+    const CameraClone* prev = clone_at(frame_ - 1);
+    if (!prev) return false;
+
+    Eigen::Matrix3d R_GtoI_prev = config_.R_ItoC0.transpose() *
+                                  prev->q_GtoC.toRotationMatrix();
+    Eigen::Matrix3d R_I = state_.q_GtoI.toRotationMatrix() * R_GtoI_prev.transpose();
+    R_C0 = config_.R_ItoC0 * R_I * config_.R_ItoC0.transpose();
+    R_C1 = config_.R_ItoC1 * R_I * config_.R_ItoC1.transpose();
+    return true;
+}
+
+// `centre` is where the search starts (from_pt without a prediction);
+// predicted box searches use the smaller predicted_search_radius.
+bool MSCKFEstimator::track_temporal(const cv::Mat& from_img, const ImagePyramid& from_pyr,
+                                    const cv::Mat& to_img, const ImagePyramid& to_pyr,
+                                    const cv::Point2f& from_pt, const cv::Point2f& centre,
+                                    bool predicted, cv::Point2f& to_pt) {
+    if (config_.tracker == VIOConfig::Tracker::lk)
+        return track_point_lk(lk_, from_pyr, to_pyr, from_pt, centre, to_pt,
+                              config_.template_size,
+                              config_.lk_max_iterations,
+                              config_.lk_epsilon,
+                              config_.match_threshold);
+    if (config_.tracker == VIOConfig::Tracker::pyramid)
+        return track_point_pyramid(ncc_, from_pyr, to_pyr, from_pt, centre, to_pt,
+                                   config_.template_size,
+                                   config_.pyramid_coarse_radius,
+                                   config_.pyramid_refine_radius,
+                                   config_.search_radius,
+                                   config_.match_threshold,
+                                   config_.subpixel);
+    return track_point_template(ncc_, from_img, to_img, from_pt, centre, to_pt,
+                                config_.template_size,
+                                predicted ? config_.predicted_search_radius
+                                          : config_.search_radius,
+                                config_.match_threshold,
+                                config_.subpixel);
+}
+
+void MSCKFEstimator::keep_as_previous(const cv::Mat& img0e, const cv::Mat& img1e) {
     prev_img0_ = img0e.clone();
     prev_img1_ = img1e.clone();
+    if (config_.tracker == VIOConfig::Tracker::box) return;
+
+    // Coarser levels move over as they are; the old ones are rebuilt into
+    // next frame. Level 0 must be the clone: img0e may be the caller's frame.
+    std::swap(prev_pyr0_, curr_pyr0_);
+    std::swap(prev_pyr1_, curr_pyr1_);
+    prev_pyr0_.levels[0] = prev_img0_;
+    prev_pyr1_.levels[0] = prev_img1_;
 }
 
 // ==============================================================================
@@ -303,7 +386,8 @@ void MSCKFEstimator::augment_state(double timestamp) {
     clone.q_GtoC.normalize();
     clone.p_CinG = state_.p_IinG + R_ItoG * config_.p_C0inI;
 
-    state_.clones[timestamp] = clone;
+    if (state_.clones.empty()) clone_frame0_ = frame_;
+    state_.clones.push_back(clone);
 
     int old_dim = state_.state_dim() - 6;   // dim before this clone was added
     int new_dim = state_.state_dim();
@@ -348,26 +432,26 @@ void MSCKFEstimator::augment_state(double timestamp) {
 // ==============================================================================
 // TRIANGULATION  (DLT, cam0 + cam1)
 // ==============================================================================
-bool MSCKFEstimator::triangulate_feature(Feature& feat) {
-    if (feat.observations.size() < 2) return false;
+bool MSCKFEstimator::triangulate_feature(size_t i, Eigen::Vector3d& p_FinG) const {
+    if (features_.length(i) < 2) return false;
 
     // Pre-allocate for 2 rows per camera per frame (cam0 + cam1)
-    int max_rows = static_cast<int>(feat.observations.size()) * 4;
+    int max_rows = features_.length(i) * 4;
     Eigen::MatrixXd A(max_rows, 3);
     Eigen::VectorXd b_vec(max_rows);
     int row = 0;
 
-    for (const auto& obs_pair : feat.observations) {
-        double t = obs_pair.first;
-        if (!state_.clones.count(t)) continue;
+    for (uint64_t f = features_.first(i); f <= features_.last(i); f++) {
+        const CameraClone* c = clone_at(f);
+        if (!c) continue;
 
-        const CameraClone& clone = state_.clones.at(t);
+        const CameraClone& clone = *c;
         Eigen::Matrix3d R_CtoG  = clone.q_GtoC.toRotationMatrix().transpose();
 
         // ── cam0 bearing ─────────────────────────────────────────────────────
         // Keep z=1 structure (no normalise()) for better DLT conditioning.
         {
-            const Eigen::Vector2d& uv0 = obs_pair.second.first;
+            const Eigen::Vector2d& uv0 = features_.uv0(i, f);
             Eigen::Vector3d bear_C(uv0(0), uv0(1), 1.0);
             Eigen::Vector3d bear_G = R_CtoG * bear_C;
             Eigen::Matrix3d Bx = skew(bear_G);
@@ -387,7 +471,7 @@ bool MSCKFEstimator::triangulate_feature(Feature& feat) {
                                            R_GtoI_clone.transpose() *
                                            (config_.p_C1inI - config_.p_C0inI);
 
-            const Eigen::Vector2d& uv1 = obs_pair.second.second;
+            const Eigen::Vector2d& uv1 = features_.uv1(i, f);
             Eigen::Vector3d bear_C(uv1(0), uv1(1), 1.0);
             Eigen::Vector3d bear_G = R_GtoC1.transpose() * bear_C;
             Eigen::Matrix3d Bx = skew(bear_G);
@@ -399,32 +483,31 @@ bool MSCKFEstimator::triangulate_feature(Feature& feat) {
 
     if (row < 6) return false;
 
-    Eigen::Vector3d p_FinG =
+    Eigen::Vector3d p =
         A.topRows(row).jacobiSvd(Eigen::ComputeThinU | Eigen::ComputeThinV)
                        .solve(b_vec.head(row));
 
-    if (!p_FinG.allFinite()) return false;
+    if (!p.allFinite()) return false;
 
     // ── Reprojection check with consistent distorted-pixel comparison ─────────
     // FIX: original mixed undistorted normalised coords (stored) with distorted
-    // pixel (project_point output). Now both sides go through project_point.
+    // pixel (project_point output). Now both sides go through the same
+    // projection (lut0_, tabulated project_point).
     double total_error = 0;
     int    count       = 0;
 
-    for (const auto& obs_pair : feat.observations) {
-        double t = obs_pair.first;
-        if (!state_.clones.count(t)) continue;
+    for (uint64_t f = features_.first(i); f <= features_.last(i); f++) {
+        const CameraClone* clone = clone_at(f);
+        if (!clone) continue;
 
-        const CameraClone& clone  = state_.clones.at(t);
-        Eigen::Matrix3d    R_GtoC = clone.q_GtoC.toRotationMatrix();
-        Eigen::Vector3d    p_FinC = R_GtoC * (p_FinG - clone.p_CinG);
+        Eigen::Matrix3d    R_GtoC = clone->q_GtoC.toRotationMatrix();
+        Eigen::Vector3d    p_FinC = R_GtoC * (p - clone->p_CinG);
 
-        Eigen::Vector2d predicted = project_point(p_FinC, config_.cam0);
+        Eigen::Vector2d predicted = lut0_.project(p_FinC);
         if (predicted(0) < 0) continue;
 
         // Forward-project stored normalised coord to get distorted observed pixel
-        Eigen::Vector3d uv0_h(obs_pair.second.first(0), obs_pair.second.first(1), 1.0);
-        Eigen::Vector2d observed = project_point(uv0_h, config_.cam0);
+        Eigen::Vector2d observed = lut0_.distort(features_.uv0(i, f));
 
         total_error += (predicted - observed).norm();
         count++;
@@ -432,21 +515,22 @@ bool MSCKFEstimator::triangulate_feature(Feature& feat) {
 
     if (count == 0 || total_error / count > config_.max_reprojection_error) return false;
 
-    feat.p_FinG       = p_FinG;
-    feat.triangulated = true;
+    p_FinG = p;
     return true;
 }
 
 // ==============================================================================
 // MSCKF UPDATE
 // ==============================================================================
-void MSCKFEstimator::msckf_update(std::vector<Feature*>& features) {
+void MSCKFEstimator::msckf_update(const std::vector<size_t>& features) {
 
     // Triangulate all candidates; keep only successful ones
-    std::vector<Feature*> good;
+    std::vector<std::pair<size_t, Eigen::Vector3d>> good;
     good.reserve(features.size());
-    for (Feature* f : features)
-        if (triangulate_feature(*f)) good.push_back(f);
+    for (size_t i : features) {
+        Eigen::Vector3d p;
+        if (triangulate_feature(i, p)) good.emplace_back(i, p);
+    }
     if (good.empty()) return;
 
     const int state_dim = state_.state_dim();
@@ -454,14 +538,16 @@ void MSCKFEstimator::msckf_update(std::vector<Feature*>& features) {
     std::vector<Eigen::MatrixXd> H_blocks;
     std::vector<Eigen::VectorXd> r_blocks;
 
-    for (Feature* feat : good) {
-        const Eigen::Vector3d& p_FinG = feat->p_FinG;
+    for (const auto& g : good) {
+        const size_t           i      = g.first;
+        const Eigen::Vector3d& p_FinG = g.second;
 
-        // Count valid observations (those with a corresponding clone in the window)
-        int n_obs = 0;
-        for (const auto& obs : feat->observations)
-            if (state_.clones.count(obs.first)) n_obs++;
-        if (n_obs == 0) continue;
+        // Valid observations: the frames of the track that have a clone.
+        // Clones are consecutive frames, so this is an overlap of two ranges.
+        uint64_t f_lo = std::max(features_.first(i), clone_frame0_);
+        uint64_t f_hi = std::min(features_.last(i), clone_frame0_ + state_.clones.size() - 1);
+        if (state_.clones.empty() || f_lo > f_hi) continue;
+        int n_obs = static_cast<int>(f_hi - f_lo + 1);
 
         // Per-feature Jacobians and residual
         Eigen::MatrixXd H_f(n_obs * 2, 3);          // w.r.t. feature position
@@ -470,11 +556,8 @@ void MSCKFEstimator::msckf_update(std::vector<Feature*>& features) {
         H_f.setZero(); H_x.setZero();
 
         int lr = 0;
-        for (const auto& obs_pair : feat->observations) {
-            double t = obs_pair.first;
-            if (!state_.clones.count(t)) continue;
-
-            const CameraClone& clone  = state_.clones.at(t);
+        for (uint64_t f = f_lo; f <= f_hi; f++) {
+            const CameraClone& clone  = *clone_at(f);
             Eigen::Matrix3d    R_GtoC = clone.q_GtoC.toRotationMatrix();
             Eigen::Vector3d    p_FinC = R_GtoC * (p_FinG - clone.p_CinG);
 
@@ -497,16 +580,12 @@ void MSCKFEstimator::msckf_update(std::vector<Feature*>& features) {
             H_f.block<2,3>(lr, 0) = J_proj * R_GtoC;
 
             // Column offset of this clone's block in P_full
-            int clone_col = 15;
-            for (const auto& c : state_.clones) {
-                if (c.first == t) break;
-                clone_col += 6;
-            }
+            int clone_col = 15 + 6 * static_cast<int>(f - clone_frame0_);
             H_x.block<2,6>(lr, clone_col) = H_clone;
 
             // Residual in normalised space (consistent with J_proj)
             Eigen::Vector2d z_hat(X / Z, Y / Z);
-            r_vec.segment<2>(lr) = obs_pair.second.first - z_hat;
+            r_vec.segment<2>(lr) = features_.uv0(i, f) - z_hat;
 
             lr += 2;
         }
@@ -576,10 +655,10 @@ void MSCKFEstimator::msckf_update(std::vector<Feature*>& features) {
     state_.b_accel += delta_x.segment<3>(12);
 
     int idx = 15;
-    for (auto& cp : state_.clones) {
-        cp.second.q_GtoC = cp.second.q_GtoC * delta_q(delta_x.segment<3>(idx));
-        cp.second.q_GtoC.normalize();
-        cp.second.p_CinG += delta_x.segment<3>(idx + 3);
+    for (CameraClone& c : state_.clones) {
+        c.q_GtoC = c.q_GtoC * delta_q(delta_x.segment<3>(idx));
+        c.q_GtoC.normalize();
+        c.p_CinG += delta_x.segment<3>(idx + 3);
         idx += 6;
     }
 
@@ -596,19 +675,12 @@ void MSCKFEstimator::msckf_update(std::vector<Feature*>& features) {
 void MSCKFEstimator::marginalize_oldest_clone() {
     if (state_.clones.empty()) return;
 
-    double oldest_time = state_.clones.begin()->first;
-
-    // FIX 1: compute clone_idx BEFORE erasing.
-    // Original erased first, then searched — the key was never found so
-    // clone_idx ended up pointing past all clones, causing OOB covariance writes.
-    int clone_idx = 15;
-    for (const auto& c : state_.clones) {
-        if (c.first == oldest_time) break;
-        clone_idx += 6;
-    }
+    // The oldest clone is the first block after the IMU state.
+    const int clone_idx = 15;
 
     const int old_dim = state_.state_dim();   // still includes the clone
-    state_.clones.erase(oldest_time);
+    state_.clones.erase(state_.clones.begin());
+    clone_frame0_++;
     const int new_dim = state_.state_dim();   // = old_dim - 6
 
     // FIX 2: plain row/column deletion, not a Schur complement.
@@ -659,34 +731,31 @@ void MSCKFEstimator::feed_imu(double timestamp,
 
 void MSCKFEstimator::feed_stereo(double timestamp,
                                   const cv::Mat& img0,
-                                  const cv::Mat& img1) {
+                                  const cv::Mat& img1,
+                                  bool pre_equalized) {
     if (img0.empty() || img1.empty()) return;
 
-    track_features(timestamp, img0, img1);
+    uint64_t t0 = read_mtime();
+    track_features(img0, img1, pre_equalized);
+    track_stats_.ticks += read_mtime() - t0;
+    track_stats_.frames++;
 
     if (!initialized_) {
         if (try_initialize(timestamp)) initialized_ = true;
+        remove_lost();   // tracks are consecutive frames before the filter runs too
         return;
     }
 
     augment_state(timestamp);
 
-    // Collect features not tracked in this frame
-    std::vector<Feature*> lost_features;
-    for (auto& kv : feature_tracks_) {
-        Feature& feat = kv.second;
-        if (!feat.observations.count(timestamp)) {
-            if (feat.observations.size() >= static_cast<size_t>(config_.min_track_length))
-                lost_features.push_back(&feat);
-            feat.should_marginalize = true;
-        }
-    }
-
-    if (!lost_features.empty()) msckf_update(lost_features);
+    // Update with the tracks lost in this frame, then drop them
+    update_set_.clear();
+    for (size_t i = 0; i < features_.size(); i++)
+        if (features_.last(i) != frame_ && features_.length(i) >= config_.min_track_length)
+            update_set_.push_back(i);
 
-    // Prune dead features
-    for (auto it = feature_tracks_.begin(); it != feature_tracks_.end(); )
-        it = it->second.should_marginalize ? feature_tracks_.erase(it) : ++it;
+    if (!update_set_.empty()) msckf_update(update_set_);
+    remove_lost();
 
     // Slide the clone window.
     // Before dropping the oldest clone, do an opportunistic MSCKF update with
@@ -694,23 +763,17 @@ void MSCKFEstimator::feed_stereo(double timestamp,
     // Without this, features tracked across the full window never contribute
     // to the EKF update until they happen to drop — wasting all that baseline.
     while (state_.clones.size() > static_cast<size_t>(config_.max_clone_size)) {
-        double oldest_time = state_.clones.begin()->first;
-
-        std::vector<Feature*> expiring;
-        for (auto& kv : feature_tracks_) {
-            Feature& feat = kv.second;
-            if (!feat.should_marginalize &&
-                feat.observations.count(oldest_time) &&
-                feat.observations.size() >= static_cast<size_t>(config_.min_track_length)) {
-                expiring.push_back(&feat);
-            }
-        }
-        if (!expiring.empty()) msckf_update(expiring);
+        const uint64_t oldest = clone_frame0_;
+
+        update_set_.clear();
+        for (size_t i = 0; i < features_.size(); i++)
+            if (features_.first(i) <= oldest && features_.length(i) >= config_.min_track_length)
+                update_set_.push_back(i);
+        if (!update_set_.empty()) msckf_update(update_set_);
 
         // Drop the oldest observation from still-live features so triangulation
         // never references a clone that no longer exists.
-        for (auto& kv : feature_tracks_)
-            kv.second.observations.erase(oldest_time);
+        features_.drop_before(oldest + 1);
 
         marginalize_oldest_clone();
     }
@@ -12,8 +12,12 @@
 #include <opencv2/core.hpp>
 #include <opencv2/imgproc.hpp>
 
+#include "ncc_engine.hpp"
+#include "lk_tracker.hpp"
+#include "grid_detector.hpp"
+#include "feature_database.hpp"
+
 #include <vector>
-#include <map>
 #include <cmath>
 #include <algorithm>
 
@@ -53,6 +57,49 @@ struct VIOConfig {
                                      // EuRoC baseline 0.11m, fx≈458 → disparity≈50px at 1m
     double match_threshold = 0.8;
     double fb_check_thresh = 2.0;    // forward-backward consistency threshold (pixels)
+    bool subpixel = true;            // parabolic peak refinement of NCC matches
+
+    // Temporal tracker: exhaustive search_radius box at full resolution, or
+    // coarse-to-fine over an image pyramid built once per frame. The pyramid
+    // follows motion up to ~coarse_radius·2^(levels-1) px with ~150 NCC
+    // candidates per feature instead of (2·search_radius+1)².
+    // Tracker::lk replaces the NCC search with inverse-compositional
+    // Lucas-Kanade on the same pyramid: template_size window, sub-pixel
+    // result, kept if the final patch correlates at match_threshold.
+    enum class Tracker { box, pyramid, lk };
+    Tracker tracker = Tracker::box;
+    int pyramid_levels = 4;          // including full resolution
+    int pyramid_coarse_radius = 4;   // search radius at the coarsest level
+    int pyramid_refine_radius = 2;   // search radius at each finer level
+    int lk_max_iterations = 20;      // per level
+    double lk_epsilon = 0.01;        // update (px) that ends a level's iterations
+
+    // Centre temporal searches where the IMU-propagated rotation since the
+    // previous frame moves each feature. The box search then only covers
+    // translation parallax and prediction error: predicted_search_radius
+    // instead of search_radius (289 instead of 1681 candidates).
+    bool imu_predict_search = true;
+    int predicted_search_radius = 8;
+
+    // Feature detection (grid_detector.hpp): FAST-9 corners ranked by
+    // Shi-Tomasi score, at most ceil(max_features / cells) per grid cell and
+    // min_feature_distance px apart. Only cells short of tracks are scanned.
+    int detect_grid_cols = 8;
+    int detect_grid_rows = 5;
+    int fast_threshold = 20;
+    int min_feature_distance = 10;
+
+    // Image size the intrinsics refer to, and the node spacing (px) of the
+    // per-camera distortion tables (CameraLut); 0 solves every point exactly.
+    int image_width = 752;
+    int image_height = 480;
+    int distortion_lut_step = 8;
+
+    // Rectify each stereo pair once per frame (CameraLut::build_rectified)
+    // and run the whole front end on the rectified images. The stereo match
+    // is then a scan along one row (track_stereo_row) instead of a walk
+    // along the epipolar line. Costs two 6-byte/px remap tables.
+    bool rectify_stereo = false;
 };
 
 // ==============================================================================
@@ -72,7 +119,7 @@ struct IMUState {
     Eigen::Vector3d b_gyro;
     Eigen::Vector3d b_accel;
     Eigen::Matrix<double, 15, 15> P_imu;
-    std::map<double, CameraClone> clones;
+    std::vector<CameraClone> clones;   // oldest first, in P_full order
     Eigen::MatrixXd P_full;
     
     IMUState() {
@@ -90,14 +137,6 @@ struct IMUState {
     int state_dim() const { return 15 + 6 * clones.size(); }
 };
 
-struct Feature {
-    size_t id;
-    std::map<double, std::pair<Eigen::Vector2d, Eigen::Vector2d>> observations;
-    Eigen::Vector3d p_FinG;
-    bool triangulated = false;
-    bool should_marginalize = false;
-};
-
 // ==============================================================================
 // HELPER FUNCTIONS
 // ==============================================================================
@@ -156,6 +195,171 @@ inline Eigen::Vector2d undistort_point(const Eigen::Vector2d& uv,
     return Eigen::Vector2d(x, y);
 }
 
+// Tabulated project_point / undistort_point for one camera. The front end
+// converts between distorted pixels and normalised coordinates for every
+// feature in both cameras each frame; with the tables, each conversion is a
+// bilinear lookup instead of a distortion evaluation or a 5-step solve.
+//
+//   undistort  pixel → normalised, nodes every `step` px over the image
+//              plus a one-node margin
+//   distort    normalised → pixel, nodes every step/f over the bounding
+//              box of the undistorted image
+//
+// At EuRoC's distortion and step 8 the interpolation error stays below
+// 0.08 px (undistort) and 0.03 px (distort) at the image corners; 6k nodes
+// per table. Points outside a table, or every point when step is 0, use the
+// exact functions.
+//
+// build_rectified() switches the camera to rectified front-end images:
+// remap() resamples each frame through the rectifying rotation and the
+// shared pinhole K, and pixel ↔ normalised becomes that homography.
+class CameraLut {
+public:
+    void build(const VIOConfig::CameraIntrinsics& cam, int cols, int rows, int step) {
+        cam_ = cam;
+        rectified_ = false;
+        map_xy_.release();
+        map_frac_.release();
+        und_.v.clear();
+        dis_.v.clear();
+        if (step <= 0 || cols <= 0 || rows <= 0) return;
+
+        und_.init(-step, -step, step, (cols + step - 1) / step + 3, (rows + step - 1) / step + 3);
+        double x_lo = 1e9, y_lo = 1e9, x_hi = -1e9, y_hi = -1e9;
+        for (int j = 0; j < und_.ny; j++) {
+            for (int i = 0; i < und_.nx; i++) {
+                Eigen::Vector2d xy = undistort_point(und_.node(i, j), cam);
+                und_.set(i, j, xy);
+                x_lo = std::min(x_lo, xy(0));  x_hi = std::max(x_hi, xy(0));
+                y_lo = std::min(y_lo, xy(1));  y_hi = std::max(y_hi, xy(1));
+            }
+        }
+
+        const double h = step / std::max(cam.fx, cam.fy);
+        dis_.init(x_lo, y_lo, h, static_cast<int>(std::ceil((x_hi - x_lo) / h)) + 2,
+                  static_cast<int>(std::ceil((y_hi - y_lo) / h)) + 2);
+        for (int j = 0; j < dis_.ny; j++) {
+            for (int i = 0; i < dis_.nx; i++) {
+                Eigen::Vector2d n = dis_.node(i, j);
+                dis_.set(i, j, project_point(Eigen::Vector3d(n(0), n(1), 1.0), cam));
+            }
+        }
+    }
+
+    // Rectified images of cols×rows: pinhole (f, cx, cy), orientation
+    // R_rect·(camera frame). Builds the fixed-point remap tables.
+    void build_rectified(const VIOConfig::CameraIntrinsics& cam, const Eigen::Matrix3d& R_rect,
+                         double f, double cx, double cy, int cols, int rows) {
+        build(cam, cols, rows, 0);
+        rectified_ = true;
+        R_rect_ = R_rect;
+        rf_ = f;
+        rcx_ = cx;
+        rcy_ = cy;
+
+        cv::Mat map_x(rows, cols, CV_32FC1), map_y(rows, cols, CV_32FC1);
+        const Eigen::Matrix3d R_back = R_rect.transpose();
+        for (int v = 0; v < rows; v++) {
+            float* mx = map_x.ptr<float>(v);
+            float* my = map_y.ptr<float>(v);
+            for (int u = 0; u < cols; u++) {
+                Eigen::Vector2d src = project_point(
+                    R_back * Eigen::Vector3d((u - cx) / f, (v - cy) / f, 1.0), cam);
+                mx[u] = static_cast<float>(src(0));
+                my[u] = static_cast<float>(src(1));
+            }
+        }
+        cv::convertMaps(map_x, map_y, map_xy_, map_frac_, CV_16SC2);
+    }
+
+    bool rectified() const { return rectified_; }
+
+    // Rectified copy of a raw frame (build_rectified() only).
+    void remap(const cv::Mat& raw, cv::Mat& out) const {
+        cv::remap(raw, out, map_xy_, map_frac_, cv::INTER_LINEAR, cv::BORDER_REPLICATE);
+    }
+
+    // undistort_point(uv, cam)
+    Eigen::Vector2d undistort(const Eigen::Vector2d& uv) const {
+        if (rectified_) {
+            Eigen::Vector3d b = R_rect_.transpose() *
+                                Eigen::Vector3d((uv(0) - rcx_) / rf_, (uv(1) - rcy_) / rf_, 1.0);
+            return b.head<2>() / b(2);
+        }
+        Eigen::Vector2d xy;
+        return und_.lookup(uv, xy) ? xy : undistort_point(uv, cam_);
+    }
+
+    // project_point((x, y, 1), cam)
+    Eigen::Vector2d distort(const Eigen::Vector2d& xy) const {
+        if (rectified_) {
+            Eigen::Vector3d b = R_rect_ * Eigen::Vector3d(xy(0), xy(1), 1.0);
+            if (b(2) <= 0) return Eigen::Vector2d(-1, -1);
+            return Eigen::Vector2d(rf_ * b(0) / b(2) + rcx_, rf_ * b(1) / b(2) + rcy_);
+        }
+        Eigen::Vector2d uv;
+        return dis_.lookup(xy, uv) ? uv : project_point(Eigen::Vector3d(xy(0), xy(1), 1.0), cam_);
+    }
+
+    // project_point(p_FinC, cam); (-1, -1) behind the camera, as project_point.
+    Eigen::Vector2d project(const Eigen::Vector3d& p_FinC) const {
+        if (p_FinC(2) <= 0) return Eigen::Vector2d(-1, -1);
+        return distort(p_FinC.head<2>() / p_FinC(2));
+    }
+
+private:
+    // nx×ny nodes at (x0 + i·h, y0 + j·h), two floats each.
+    struct Grid {
+        double x0 = 0, y0 = 0, h = 1, inv_h = 1;
+        int    nx = 0, ny = 0;
+        std::vector<float> v;
+
+        void init(double x0_, double y0_, double h_, int nx_, int ny_) {
+            x0 = x0_;  y0 = y0_;  h = h_;  inv_h = 1.0 / h_;
+            nx = nx_;  ny = ny_;
+            v.assign(static_cast<size_t>(nx) * ny * 2, 0.0f);
+        }
+        Eigen::Vector2d node(int i, int j) const { return Eigen::Vector2d(x0 + i * h, y0 + j * h); }
+        void set(int i, int j, const Eigen::Vector2d& p) {
+            size_t k = (static_cast<size_t>(j) * nx + i) * 2;
+            v[k]     = static_cast<float>(p(0));
+            v[k + 1] = static_cast<float>(p(1));
+        }
+        bool lookup(const Eigen::Vector2d& p, Eigen::Vector2d& out) const {
+            if (v.empty()) return false;
+            double gx = (p(0) - x0) * inv_h, gy = (p(1) - y0) * inv_h;
+            if (!(gx >= 0.0 && gy >= 0.0 && gx < nx - 1 && gy < ny - 1)) return false;
+            int ix = static_cast<int>(gx), iy = static_cast<int>(gy);
+            double fx = gx - ix, fy = gy - iy;
+            const float* a = &v[(static_cast<size_t>(iy) * nx + ix) * 2];
+            const float* b = a + static_cast<size_t>(nx) * 2;
+            for (int c = 0; c < 2; c++)
+                out(c) = (1 - fy) * ((1 - fx) * a[c] + fx * a[c + 2]) +
+                         fy       * ((1 - fx) * b[c] + fx * b[c + 2]);
+            return true;
+        }
+    };
+
+    VIOConfig::CameraIntrinsics cam_{};
+    Grid und_, dis_;
+
+    bool            rectified_ = false;
+    Eigen::Matrix3d R_rect_ = Eigen::Matrix3d::Identity();
+    double          rf_ = 1, rcx_ = 0, rcy_ = 0;
+    cv::Mat         map_xy_, map_frac_;   // cv::convertMaps fixed-point remap tables
+};
+
+// Pixel of the normalised bearing (x, y, 1) after rotating it by R; false if
+// it ends up behind the camera.
+inline bool rotate_to_pixel(const Eigen::Matrix3d& R, const Eigen::Vector2d& xy,
+                            const CameraLut& cam, cv::Point2f& px) {
+    Eigen::Vector3d b = R * Eigen::Vector3d(xy(0), xy(1), 1.0);
+    if (b(2) <= 0) return false;
+    Eigen::Vector2d uv = cam.project(b);
+    px = cv::Point2f(uv(0), uv(1));
+    return true;
+}
+
 // ==============================================================================
 // TEMPLATE MATCHING (Replaces KLT)
 // ==============================================================================
@@ -201,34 +405,39 @@ inline double ncc_match(const cv::Mat& img1, const cv::Mat& img2,
     return covar / sqrt(var1 * var2);
 }
 
-inline bool track_point_template(const cv::Mat& prev_img, const cv::Mat& curr_img,
-                                 const cv::Point2f& prev_pt, cv::Point2f& curr_pt,
-                                 int template_size, int search_radius, double threshold) {
-    int x0 = (int)prev_pt.x;
-    int y0 = (int)prev_pt.y;
-    
-    double best_score = -1.0;
-    int best_x = x0, best_y = y0;
-    
-    for (int dy = -search_radius; dy <= search_radius; dy++) {
-        for (int dx = -search_radius; dx <= search_radius; dx++) {
-            int x = x0 + dx;
-            int y = y0 + dy;
-            
-            double score = ncc_match(prev_img, curr_img, x0, y0, x, y, template_size);
-            
-            if (score > best_score) {
-                best_score = score;
-                best_x = x;
-                best_y = y;
-            }
-        }
-    }
-    
+inline GrayView gray_view(const cv::Mat& img) {
+    return GrayView{img.data, img.cols, img.rows, img.step};
+}
+
+// Window search with the integral-image engine; same result as evaluating
+// ncc_match at every offset in the (2r+1)² window.
+// Match position of a template taken at the integer pixel (int)prev_pt. With
+// `subpixel`, the peak is refined and prev_pt's own fraction carried over,
+// so a sub-pixel feature stays sub-pixel from frame to frame.
+inline cv::Point2f ncc_match_position(const NccEngine& ncc, int best_x, int best_y,
+                                      const cv::Point2f& prev_pt, bool subpixel) {
+    if (!subpixel) return cv::Point2f(best_x, best_y);
+    double sx, sy;
+    ncc_refine_subpixel(ncc, best_x, best_y, sx, sy);
+    return cv::Point2f(sx + (prev_pt.x - (int)prev_pt.x), sy + (prev_pt.y - (int)prev_pt.y));
+}
+
+// The window is centred on `search_centre` (prev_pt, or a predicted position).
+inline bool track_point_template(NccEngine& ncc,
+                                 const cv::Mat& prev_img, const cv::Mat& curr_img,
+                                 const cv::Point2f& prev_pt, const cv::Point2f& search_centre,
+                                 cv::Point2f& curr_pt,
+                                 int template_size, int search_radius, double threshold,
+                                 bool subpixel) {
+    int best_x, best_y;
+    double best_score = ncc_search_window(ncc, gray_view(prev_img), gray_view(curr_img),
+                                          (int)prev_pt.x, (int)prev_pt.y,
+                                          (int)search_centre.x, (int)search_centre.y,
+                                          template_size, search_radius, best_x, best_y);
+
     if (best_score < threshold) return false;
-    
-    curr_pt.x = best_x;
-    curr_pt.y = best_y;
+
+    curr_pt = ncc_match_position(ncc, best_x, best_y, prev_pt, subpixel);
     return true;
 }
 
@@ -236,14 +445,18 @@ inline bool track_point_template(const cv::Mat& prev_img, const cv::Mat& curr_im
 // l = F * [x0, y0, 1]^T  is the epipolar line ax+by+c=0 in the right image.
 // We step along the line from disparity -disp_max to +disp_max (in x),
 // evaluating NCC against the template extracted from img_left at (x0,y0).
-// This replaces the O(r²) box search with an O(r) line search.
-inline bool track_stereo_epipolar(const cv::Mat& img_left, const cv::Mat& img_right,
+// This replaces the O(r²) box search with an O(r) line search; the engine's
+// integral images span only the line's bounding box. With `subpixel`, x is
+// refined by a parabola through the horizontal neighbours and y is put back
+// on the epipolar line.
+inline bool track_stereo_epipolar(NccEngine& ncc,
+                                  const cv::Mat& img_left, const cv::Mat& img_right,
                                   const cv::Point2f& pt_left, cv::Point2f& pt_right,
                                   const Eigen::Matrix3d& F,
-                                  int template_size, int disp_max, double threshold) {
+                                  int template_size, int disp_max, double threshold,
+                                  bool subpixel) {
     int x0 = (int)pt_left.x;
     int y0 = (int)pt_left.y;
-    int half = template_size / 2;
 
     // Epipolar line in right image: [a, b, c] = F * [x0, y0, 1]
     Eigen::Vector3d l = F * Eigen::Vector3d(x0, y0, 1.0);
@@ -251,18 +464,22 @@ inline bool track_stereo_epipolar(const cv::Mat& img_left, const cv::Mat& img_ri
     double denom = std::sqrt(a*a + b*b);
     if (denom < 1e-9) return false;
 
-    double best_score = -1.0;
-    int best_x = x0, best_y = y0;
+    if (!ncc.set_template(gray_view(img_left), x0, y0, template_size)) return false;
 
     // Step along x from x0-disp_max to x0+disp_max, compute y from line eq
-    for (int dx = -disp_max; dx <= disp_max; dx++) {
-        int xi = x0 + dx;
-        int yi = static_cast<int>(std::round(-(a * xi + c) / b));
+    auto line_y = [&](int xi) { return static_cast<int>(std::round(-(a * xi + c) / b)); };
+    int ya = line_y(x0 - disp_max), yb = line_y(x0 + disp_max);
+    if (!ncc.prepare(gray_view(img_right), x0 - disp_max, std::min(ya, yb),
+                     x0 + disp_max, std::max(ya, yb))) return false;
 
-        if (xi - half < 0 || xi + half >= img_right.cols ||
-            yi - half < 0 || yi + half >= img_right.rows) continue;
+    double best_score = -1.0;
+    int best_x = x0, best_y = y0;
 
-        double score = ncc_match(img_left, img_right, x0, y0, xi, yi, template_size);
+    for (int xi = ncc.cx_lo(); xi <= ncc.cx_hi(); xi++) {
+        int yi = line_y(xi);
+        if (!ncc.contains(xi, yi)) continue;
+
+        double score = ncc.score(xi, yi);
         if (score > best_score) {
             best_score = score;
             best_x = xi;
@@ -273,16 +490,248 @@ inline bool track_stereo_epipolar(const cv::Mat& img_left, const cv::Mat& img_ri
     if (best_score < threshold) return false;
     pt_right.x = best_x;
     pt_right.y = best_y;
+    if (subpixel) {
+        double sx = best_x + ncc_parabola_peak(ncc.score(best_x - 1, best_y), best_score,
+                                               ncc.score(best_x + 1, best_y));
+        pt_right.x = sx;
+        pt_right.y = -(a * sx + c) / b;
+    }
+    return true;
+}
+
+// Rectified stereo: the match lies on the same row of the right image, at a
+// disparity of 0..disp_max px (one more pixel each side for noise and the
+// sub-pixel fit). The integral images cover a single template-high strip
+// and the candidates are consecutive addresses along it.
+inline bool track_stereo_row(NccEngine& ncc,
+                             const cv::Mat& img_left, const cv::Mat& img_right,
+                             const cv::Point2f& pt_left, cv::Point2f& pt_right,
+                             int template_size, int disp_max, double threshold,
+                             bool subpixel) {
+    int x0 = (int)pt_left.x;
+    int y0 = (int)pt_left.y;
+
+    if (!ncc.set_template(gray_view(img_left), x0, y0, template_size)) return false;
+    if (!ncc.prepare(gray_view(img_right), x0 - disp_max - 1, y0, x0 + 1, y0)) return false;
+
+    double best_score = -1.0;
+    int best_x = x0;
+    for (int xi = ncc.cx_lo(); xi <= ncc.cx_hi(); xi++) {
+        double score = ncc.score(xi, y0);
+        if (score > best_score) {
+            best_score = score;
+            best_x = xi;
+        }
+    }
+
+    if (best_score < threshold) return false;
+    pt_right = ncc_match_position(ncc, best_x, y0, pt_left, subpixel);
     return true;
 }
 
+// Gaussian pyramid: level 0 is the image itself (shared, not copied), each
+// level above is cv::pyrDown of the one below. Rebuilding into the same
+// object reuses the level buffers.
+struct ImagePyramid {
+    std::vector<cv::Mat> levels;
+
+    void build(const cv::Mat& img, int num_levels) {
+        levels.resize(std::max(num_levels, 1));
+        levels[0] = img;
+        for (size_t l = 1; l < levels.size(); l++)
+            cv::pyrDown(levels[l - 1], levels[l]);
+    }
+
+    int size() const { return static_cast<int>(levels.size()); }
+};
+
+// Coarse-to-fine template tracking. The template is taken at prev_pt's
+// position on every level; the displacement found on one level, doubled,
+// centres the search on the next. The first level where the template fits
+// (features near the border skip the coarsest ones) starts from the
+// search_centre − prev_pt displacement and searches
+// coarse_radius·2^(levels above it), capped at max_radius; later levels only
+// refine_radius. match_threshold applies at full resolution.
+inline bool track_point_pyramid(NccEngine& ncc,
+                                const ImagePyramid& prev, const ImagePyramid& curr,
+                                const cv::Point2f& prev_pt, const cv::Point2f& search_centre,
+                                cv::Point2f& curr_pt,
+                                int template_size, int coarse_radius, int refine_radius,
+                                int max_radius, double threshold, bool subpixel) {
+    int x0 = (int)prev_pt.x;
+    int y0 = (int)prev_pt.y;
+    int top = std::min(prev.size(), curr.size()) - 1;
+    double guess_dx = (int)search_centre.x - x0;
+    double guess_dy = (int)search_centre.y - y0;
+
+    int  dx = 0, dy = 0;    // displacement estimate at the current level
+    bool seeded = false;
+    for (int l = top; l >= 0; l--) {
+        if (seeded) {
+            dx *= 2;
+            dy *= 2;
+        } else {
+            dx = static_cast<int>(std::lround(std::ldexp(guess_dx, -l)));
+            dy = static_cast<int>(std::lround(std::ldexp(guess_dy, -l)));
+        }
+        int tx = x0 >> l, ty = y0 >> l;
+        int radius = seeded ? refine_radius
+                            : std::min(coarse_radius << (top - l), max_radius);
+
+        int best_x, best_y;
+        double score = ncc_search_window(ncc, gray_view(prev.levels[l]), gray_view(curr.levels[l]),
+                                         tx, ty, tx + dx, ty + dy,
+                                         template_size, radius, best_x, best_y);
+        if (l == 0) {
+            if (score < threshold) return false;
+            curr_pt = ncc_match_position(ncc, best_x, best_y, prev_pt, subpixel);
+            return true;
+        }
+        if (score > -1.0) {
+            dx = best_x - tx;
+            dy = best_y - ty;
+            seeded = true;
+        }
+    }
+    return false;
+}
+
+// Lucas-Kanade tracking over the pyramids, from the search_centre guess.
+inline bool track_point_lk(LkTracker& lk,
+                           const ImagePyramid& prev, const ImagePyramid& curr,
+                           const cv::Point2f& prev_pt, const cv::Point2f& search_centre,
+                           cv::Point2f& curr_pt,
+                           int window, int max_iterations, double epsilon, double threshold) {
+    constexpr int kMaxLevels = 8;
+    GrayView prev_v[kMaxLevels], curr_v[kMaxLevels];
+    int levels = std::min({prev.size(), curr.size(), kMaxLevels});
+    for (int l = 0; l < levels; l++) {
+        prev_v[l] = gray_view(prev.levels[l]);
+        curr_v[l] = gray_view(curr.levels[l]);
+    }
+    return lk.track(prev_v, curr_v, levels, prev_pt.x, prev_pt.y,
+                    search_centre.x, search_centre.y, window, max_iterations,
+                    static_cast<float>(epsilon), threshold, curr_pt.x, curr_pt.y);
+}
+
 // ==============================================================================
 // MSCKF ESTIMATOR
 // ==============================================================================
+
+// Front-end cost and yield over the run, to compare trackers.
+struct TrackStats {
+    uint64_t ticks = 0;        // read_mtime ticks spent in track_features
+    size_t   frames = 0;
+    size_t   attempted = 0;    // temporal tracks tried
+    size_t   tracked = 0;      // ... that passed the forward-backward check
+};
+
 class MSCKFEstimator {
 public:
     MSCKFEstimator(const VIOConfig& config)
-        : config_(config), initialized_(false), feature_id_counter_(0) {
+        : config_(config), initialized_(false), feature_id_counter_(0),
+          frame_(0), clone_frame0_(0) {
+        compute_stereo_fundamental();
+        build_camera_luts();
+        // A track spans at most the clone window plus the frame being added.
+        features_.reset(config_.max_clone_size + 1, 2 * config_.max_features);
+        state_.clones.reserve(config_.max_clone_size + 1);
+    }
+
+    // Scale both camera intrinsics for images resized by `scale` relative to
+    // the calibration resolution (e.g. frames embedded pre-downscaled).
+    // Distortion coefficients act on normalised coordinates and are unchanged.
+    void rescale_cameras(double scale) {
+        for (VIOConfig::CameraIntrinsics* cam : {&config_.cam0, &config_.cam1}) {
+            cam->fx *= scale;
+            cam->fy *= scale;
+            cam->cx  = (cam->cx + 0.5) * scale - 0.5;
+            cam->cy  = (cam->cy + 0.5) * scale - 0.5;
+        }
+        config_.image_width  = static_cast<int>(std::lround(config_.image_width  * scale));
+        config_.image_height = static_cast<int>(std::lround(config_.image_height * scale));
+        compute_stereo_fundamental();
+        build_camera_luts();
+    }
+
+    void feed_imu(double timestamp, const Eigen::Vector3d& w, const Eigen::Vector3d& a);
+    // pre_equalized: images were histogram-equalized offline, skip it here.
+    void feed_stereo(double timestamp, const cv::Mat& img0, const cv::Mat& img1,
+                     bool pre_equalized = false);
+    
+    bool is_initialized() const { return initialized_; }
+    const IMUState& get_state() const { return state_; }
+    const TrackStats& track_stats() const { return track_stats_; }
+    
+private:
+    VIOConfig config_;
+    IMUState state_;
+    bool initialized_;
+    
+    struct IMUMeasurement { double timestamp; Eigen::Vector3d w, a; };
+    std::vector<IMUMeasurement> imu_buffer_;
+    
+    cv::Mat prev_img0_, prev_img1_;
+    ImagePyramid prev_pyr0_, prev_pyr1_;   // Tracker::pyramid and ::lk only
+    ImagePyramid curr_pyr0_, curr_pyr1_;
+    FeatureDatabase features_;
+    std::vector<size_t> update_set_;   // feature indices for msckf_update, reused
+    size_t feature_id_counter_;
+    uint64_t frame_;             // sequence number of the frame being processed
+    uint64_t clone_frame0_;      // frame of state_.clones[0]; clones are consecutive
+    Eigen::Matrix3d F_stereo_;   // pre-computed fundamental matrix cam0→cam1
+    NccEngine ncc_;              // template + integral-image scratch, reused per search
+    LkTracker lk_;               // template / gradient scratch, reused per track
+    GridDetector detector_;      // bucket / occupancy grids, reset per detection
+    CameraLut lut0_, lut1_;      // distortion tables, rebuilt with the intrinsics
+    cv::Mat rect0_, rect1_;      // rectified frame buffers (rectify_stereo)
+    TrackStats track_stats_;
+
+    // Clone of `frame`, or nullptr if it has none (before initialisation,
+    // or already marginalised).
+    const CameraClone* clone_at(uint64_t frame) const {
+        if (frame < clone_frame0_ || frame - clone_frame0_ >= state_.clones.size()) return nullptr;
+        return &state_.clones[static_cast<size_t>(frame - clone_frame0_)];
+    }
+
+    void build_camera_luts() {
+        if (config_.rectify_stereo) {
+            build_rectification();
+            return;
+        }
+        lut0_.build(config_.cam0, config_.image_width, config_.image_height,
+                    config_.distortion_lut_step);
+        lut1_.build(config_.cam1, config_.image_width, config_.image_height,
+                    config_.distortion_lut_step);
+    }
+
+    // Both cameras rotated to a common orientation with x along the
+    // baseline (cam0 → cam1) and z halfway between the two optical axes,
+    // and a shared pinhole K with the mean focal length and principal point.
+    void build_rectification() {
+        Eigen::Matrix3d R_10 = config_.R_ItoC1 * config_.R_ItoC0.transpose();   // cam0 → cam1
+        Eigen::Vector3d e1 = (config_.R_ItoC0 * (config_.p_C1inI - config_.p_C0inI)).normalized();
+        Eigen::Vector3d z  = (Eigen::Vector3d::UnitZ() +
+                              R_10.transpose() * Eigen::Vector3d::UnitZ()).normalized();
+        Eigen::Vector3d e2 = z.cross(e1).normalized();
+        Eigen::Vector3d e3 = e1.cross(e2);
+
+        Eigen::Matrix3d R_rect0;
+        R_rect0.row(0) = e1.transpose();
+        R_rect0.row(1) = e2.transpose();
+        R_rect0.row(2) = e3.transpose();
+        Eigen::Matrix3d R_rect1 = R_rect0 * R_10.transpose();
+
+        const VIOConfig::CameraIntrinsics& c0 = config_.cam0;
+        const VIOConfig::CameraIntrinsics& c1 = config_.cam1;
+        double f  = 0.25 * (c0.fx + c0.fy + c1.fx + c1.fy);
+        double cx = 0.5 * (c0.cx + c1.cx);
+        double cy = 0.5 * (c0.cy + c1.cy);
+        lut0_.build_rectified(c0, R_rect0, f, cx, cy, config_.image_width, config_.image_height);
+        lut1_.build_rectified(c1, R_rect1, f, cx, cy, config_.image_width, config_.image_height);
+    }
+
+    void compute_stereo_fundamental() {
         // Pre-compute stereo fundamental matrix F = K1^{-T} E K0^{-1}
         // where E = [t_10]× R_10, R_10/t_10 are the relative pose from cam0 to cam1.
         Eigen::Matrix3d R_ItoC0 = config_.R_ItoC0;
@@ -308,32 +757,21 @@ public:
         F_stereo_ = K1_invT.transpose() * E * K0_inv;
     }
     
-    void feed_imu(double timestamp, const Eigen::Vector3d& w, const Eigen::Vector3d& a);
-    void feed_stereo(double timestamp, const cv::Mat& img0, const cv::Mat& img1);
-    
-    bool is_initialized() const { return initialized_; }
-    const IMUState& get_state() const { return state_; }
-    
-private:
-    VIOConfig config_;
-    IMUState state_;
-    bool initialized_;
-    
-    struct IMUMeasurement { double timestamp; Eigen::Vector3d w, a; };
-    std::vector<IMUMeasurement> imu_buffer_;
-    
-    cv::Mat prev_img0_, prev_img1_;
-    std::map<size_t, Feature> feature_tracks_;
-    size_t feature_id_counter_;
-    Eigen::Matrix3d F_stereo_;   // pre-computed fundamental matrix cam0→cam1
-    
     void propagate_imu(double timestamp, const Eigen::Vector3d& w_m, const Eigen::Vector3d& a_m);
     bool try_initialize(double timestamp);
-    void track_features(double timestamp, const cv::Mat& img0, const cv::Mat& img1);
+    void track_features(const cv::Mat& img0, const cv::Mat& img1, bool pre_equalized);
+    bool predict_rotation(Eigen::Matrix3d& R_C0, Eigen::Matrix3d& R_C1) const;
+    bool track_temporal(const cv::Mat& from_img, const ImagePyramid& from_pyr,
+                        const cv::Mat& to_img, const ImagePyramid& to_pyr,
+                        const cv::Point2f& from_pt, const cv::Point2f& centre,
+                        bool predicted, cv::Point2f& to_pt);
+    void keep_as_previous(const cv::Mat& img0e, const cv::Mat& img1e);
+    void detect_features(const cv::Mat& img0e, const cv::Mat& img1e, int active);
+    void remove_lost();
     double epipolar_distance(const cv::Point2f& p0, const cv::Point2f& p1) const;
     void augment_state(double timestamp);
-    bool triangulate_feature(Feature& feat);
-    void msckf_update(std::vector<Feature*>& features);
+    bool triangulate_feature(size_t i, Eigen::Vector3d& p_FinG) const;
+    void msckf_update(const std::vector<size_t>& features);
     void marginalize_oldest_clone();
 };
 
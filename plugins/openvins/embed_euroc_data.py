@@ -3,28 +3,73 @@
 embed_euroc_data.py
 
 Reads EuRoC MAV dataset and generates C++ headers:
-  - embedded_imu.hpp   : IMU samples as a struct array
-  - embedded_cam.hpp   : PNG file bytes as uint8_t arrays + index table
+  - embedded_imu.hpp   : IMU samples, in one of three layouts
+        aos  : struct array, int64 timestamp + 6 doubles (56 B/sample)
+        f32  : structure-of-arrays, uint32 delta timestamps + 6 float channels (28 B/sample)
+        i16  : structure-of-arrays, uint32 delta timestamps + 6 scaled int16 channels (16 B/sample)
+  - embedded_cam.hpp   : camera frames + index table, in one of three formats
+        png  : original PNG file bytes, decoded on target with libpng
+        raw  : GRAY8 pixels, 64-byte aligned, wrapped zero-copy in a cv::Mat
+        lz4  : GRAY8 pixels compressed as LZ4 blocks (src/helper/lz4_block.hpp)
+
+raw/lz4 frames can also be histogram-equalized (same LUT as cv::equalizeHist)
+and/or box-downscaled by an integer factor at embed time, so the target skips
+that work too.
 
 Usage:
   python3 embed_euroc_data.py <euroc_mav0_dir> <output_dir> [num_cam_frames]
+                              [--cam-format png|raw|lz4] [--equalize]
+                              [--downscale N] [--report]
+                              [--imu-format aos|f32|i16]
 
 Example:
-  python3 embed_euroc_data.py data/V1_02_medium/mav0 generated 50
+  python3 embed_euroc_data.py data/V1_02_medium/mav0 generated 50 --cam-format raw --equalize
+
+--report prints a size/speed comparison of the three formats at the end. It
+decodes every PNG and LZ4-compresses every frame in pure Python, so it is
+slow; leave it off for plain embeds. Target-side decode time per frame is
+printed by offline_cam at end of stream.
 """
 
+import argparse
 import csv
 import os
+import struct
 import sys
+import time
+import zlib
+
+CAM_FORMATS = ["png", "raw", "lz4"]
+IMU_FORMATS = ["aos", "f32", "i16"]
+IMU_CHANNELS = ["wx", "wy", "wz", "ax", "ay", "az"]
+ROW_ALIGN   = 16   # raw row stride alignment (bytes)
+BASE_ALIGN  = 64   # alignas() of each raw/lz4 frame array
 
 def main():
-    if len(sys.argv) < 3:
-        print(f"Usage: {sys.argv[0]} <mav0_dir> <output_dir> [num_frames]")
-        sys.exit(1)
+    parser = argparse.ArgumentParser(description="Embed EuRoC IMU + stereo frames as C++ headers")
+    parser.add_argument("mav0_dir")
+    parser.add_argument("out_dir")
+    parser.add_argument("num_frames", nargs="?", type=int, default=50)
+    parser.add_argument("--cam-format", choices=CAM_FORMATS, default="png",
+                        help="how camera frames are stored (default: png)")
+    parser.add_argument("--equalize", action="store_true",
+                        help="raw/lz4 only: histogram-equalize frames at embed time")
+    parser.add_argument("--downscale", type=int, default=1,
+                        help="raw/lz4 only: box-downscale frames by this integer factor")
+    parser.add_argument("--report", action="store_true",
+                        help="print a png/raw/lz4 size and speed comparison (slow)")
+    parser.add_argument("--imu-format", choices=IMU_FORMATS, default="aos",
+                        help="IMU sample layout (default: aos)")
+    args = parser.parse_args()
 
-    mav0_dir = sys.argv[1]
-    out_dir = sys.argv[2]
-    num_frames = int(sys.argv[3]) if len(sys.argv) > 3 else 50
+    if args.cam_format == "png" and (args.equalize or args.downscale != 1):
+        parser.error("--equalize/--downscale need --cam-format raw or lz4")
+    if args.downscale < 1:
+        parser.error("--downscale must be >= 1")
+
+    mav0_dir = args.mav0_dir
+    out_dir = args.out_dir
+    num_frames = args.num_frames
 
     os.makedirs(out_dir, exist_ok=True)
 
@@ -78,73 +123,175 @@ def main():
     print(f"Embedding {len(cam0_entries)} cam0 frames, {len(cam1_entries)} cam1 frames, {len(imu_entries)} IMU samples")
 
     # ── Generate embedded_imu.hpp ─────────────────────────────────────
-    with open(os.path.join(out_dir, "embedded_imu.hpp"), "w") as f:
-        f.write("#pragma once\n")
-        f.write("#include <cstdint>\n")
-        f.write("#include <cstddef>\n\n")
-        f.write(f"static constexpr size_t kEmbeddedImuCount = {len(imu_entries)};\n\n")
-        f.write("struct EmbeddedImuSample {\n")
-        f.write("    int64_t ts_ns;\n")
-        f.write("    double wx, wy, wz;  // rad/s\n")
-        f.write("    double ax, ay, az;  // m/s^2\n")
-        f.write("};\n\n")
-        f.write("static const EmbeddedImuSample kEmbeddedImu[] = {\n")
-        for ts, wx, wy, wz, ax, ay, az in imu_entries:
-            f.write(f"    {{{ts}LL, {wx:.17e}, {wy:.17e}, {wz:.17e}, {ax:.17e}, {ay:.17e}, {az:.17e}}},\n")
-        f.write("};\n")
-
-    print(f"  Wrote embedded_imu.hpp ({len(imu_entries)} samples)")
+    write_imu_header(os.path.join(out_dir, "embedded_imu.hpp"), imu_entries, args.imu_format)
+    print(f"  Wrote embedded_imu.hpp ({len(imu_entries)} samples, {args.imu_format})")
 
     # ── Generate embedded_cam.hpp ─────────────────────────────────────
-    # Each PNG becomes a uint8_t array. We generate an index table.
+    # Each frame becomes a uint8_t array. We generate an index table.
+    report = FormatReport() if args.report else None
+    width = height = stride = 0
+
     with open(os.path.join(out_dir, "embedded_cam.hpp"), "w") as f:
         f.write("#pragma once\n")
         f.write("#include <cstdint>\n")
         f.write("#include <cstddef>\n\n")
-        f.write(f"static constexpr size_t kEmbeddedCamCount = {len(cam0_entries)};\n\n")
 
-        # Embed each PNG as a byte array
+        frame_sizes = []
         total_bytes = 0
         for i, ((ts0, fn0), (ts1, fn1)) in enumerate(zip(cam0_entries, cam1_entries)):
-            # cam0
-            png0_path = os.path.join(mav0_dir, "cam0", "data", fn0)
-            with open(png0_path, "rb") as pf:
-                data0 = pf.read()
-            f.write(f"// cam0 frame {i}: {fn0} ({len(data0)} bytes)\n")
-            f.write(f"static const uint8_t kCam0Frame{i}[] = {{\n")
-            write_byte_array(f, data0)
-            f.write(f"}};\n\n")
-
-            # cam1
-            png1_path = os.path.join(mav0_dir, "cam1", "data", fn1)
-            with open(png1_path, "rb") as pf:
-                data1 = pf.read()
-            f.write(f"// cam1 frame {i}: {fn1} ({len(data1)} bytes)\n")
-            f.write(f"static const uint8_t kCam1Frame{i}[] = {{\n")
-            write_byte_array(f, data1)
-            f.write(f"}};\n\n")
-
-            total_bytes += len(data0) + len(data1)
+            sizes = []
+            for cam, fn in (("cam0", fn0), ("cam1", fn1)):
+                png_path = os.path.join(mav0_dir, cam, "data", fn)
+                with open(png_path, "rb") as pf:
+                    png = pf.read()
+
+                raw = None
+                if args.cam_format != "png" or report:
+                    w, h, pixels = decode_png_gray8(png)
+                    w, h, pixels = downscale_box(w, h, pixels, args.downscale)
+                    if args.equalize:
+                        pixels = equalize_hist(pixels)
+                    raw_stride = align_up(w, ROW_ALIGN)
+                    raw = pad_rows(w, h, pixels, raw_stride)
+                    width, height, stride = w, h, raw_stride
+
+                if args.cam_format == "png":
+                    data = png
+                    # IHDR geometry; offline_cam sizes its decode slots from it.
+                    width, height = struct.unpack(">II", png[16:24])
+                    stride = width
+                elif args.cam_format == "raw":
+                    data = raw
+                else:
+                    data = lz4_compress_block(raw)
+
+                if report:
+                    report.add(png, raw, data if args.cam_format == "lz4" else None)
+
+                array = f"k{cam.capitalize()}Frame{i}"
+                align = "" if args.cam_format == "png" else f"alignas({BASE_ALIGN}) "
+                f.write(f"// {cam} frame {i}: {fn} ({len(data)} bytes, {args.cam_format})\n")
+                f.write(f"{align}static const uint8_t {array}[] = {{\n")
+                write_byte_array(f, data)
+                f.write(f"}};\n\n")
+
+                sizes.append(len(data))
+                total_bytes += len(data)
+            frame_sizes.append(sizes)
+
+        # Format description (ids match CAM_FORMATS order)
+        f.write("#define EMBEDDED_CAM_FORMAT_PNG 0\n")
+        f.write("#define EMBEDDED_CAM_FORMAT_RAW 1\n")
+        f.write("#define EMBEDDED_CAM_FORMAT_LZ4 2\n")
+        f.write(f"#define EMBEDDED_CAM_FORMAT     EMBEDDED_CAM_FORMAT_{args.cam_format.upper()}\n\n")
+        f.write(f"static constexpr size_t kEmbeddedCamCount = {len(cam0_entries)};\n")
+        f.write("// decoded GRAY8 geometry, row stride in bytes\n")
+        f.write(f"static constexpr int  kEmbeddedCamWidth     = {width};\n")
+        f.write(f"static constexpr int  kEmbeddedCamHeight    = {height};\n")
+        f.write(f"static constexpr int  kEmbeddedCamStride    = {stride};\n")
+        f.write(f"static constexpr int  kEmbeddedCamDownscale = {args.downscale};\n")
+        f.write(f"static constexpr bool kEmbeddedCamEqualized = {'true' if args.equalize else 'false'};\n\n")
 
         # Index table
         f.write("struct EmbeddedCamFrame {\n")
         f.write("    int64_t ts_ns;\n")
-        f.write("    const uint8_t* cam0_png;\n")
+        f.write("    const uint8_t* cam0_data;\n")
         f.write("    size_t cam0_size;\n")
-        f.write("    const uint8_t* cam1_png;\n")
+        f.write("    const uint8_t* cam1_data;\n")
         f.write("    size_t cam1_size;\n")
         f.write("};\n\n")
 
         f.write("static const EmbeddedCamFrame kEmbeddedCam[] = {\n")
-        for i, ((ts0, fn0), (ts1, fn1)) in enumerate(zip(cam0_entries, cam1_entries)):
-            png0_path = os.path.join(mav0_dir, "cam0", "data", fn0)
-            png1_path = os.path.join(mav0_dir, "cam1", "data", fn1)
-            sz0 = os.path.getsize(png0_path)
-            sz1 = os.path.getsize(png1_path)
+        for i, ((ts0, fn0), (sz0, sz1)) in enumerate(zip(cam0_entries, frame_sizes)):
             f.write(f"    {{{ts0}LL, kCam0Frame{i}, {sz0}, kCam1Frame{i}, {sz1}}},\n")
         f.write("};\n")
 
-    print(f"  Wrote embedded_cam.hpp ({len(cam0_entries)} stereo pairs, {total_bytes / 1024 / 1024:.1f} MB)")
+    print(f"  Wrote embedded_cam.hpp ({len(cam0_entries)} stereo pairs, {total_bytes / 1024 / 1024:.1f} MB, {args.cam_format})")
+
+    if report:
+        report.print(width, height, args)
+
+
+# ==============================================================================
+# IMU LAYOUTS
+# ==============================================================================
+
+def write_imu_header(path, imu_entries, fmt):
+    with open(path, "w") as f:
+        f.write("#pragma once\n")
+        f.write("#include <cstdint>\n")
+        f.write("#include <cstddef>\n\n")
+        f.write("#define EMBEDDED_IMU_FORMAT_AOS 0\n")
+        f.write("#define EMBEDDED_IMU_FORMAT_F32 1\n")
+        f.write("#define EMBEDDED_IMU_FORMAT_I16 2\n")
+        f.write(f"#define EMBEDDED_IMU_FORMAT     EMBEDDED_IMU_FORMAT_{fmt.upper()}\n\n")
+        f.write(f"static constexpr size_t kEmbeddedImuCount = {len(imu_entries)};\n\n")
+
+        if fmt == "aos":
+            f.write("struct EmbeddedImuSample {\n")
+            f.write("    int64_t ts_ns;\n")
+            f.write("    double wx, wy, wz;  // rad/s\n")
+            f.write("    double ax, ay, az;  // m/s^2\n")
+            f.write("};\n\n")
+            f.write("static const EmbeddedImuSample kEmbeddedImu[] = {\n")
+            for ts, wx, wy, wz, ax, ay, az in imu_entries:
+                f.write(f"    {{{ts}LL, {wx:.17e}, {wy:.17e}, {wz:.17e}, {ax:.17e}, {ay:.17e}, {az:.17e}}},\n")
+            f.write("};\n")
+            return
+
+        # Structure of arrays: delta timestamps + one array per channel.
+        t0 = imu_entries[0][0]
+        deltas = [0] + [b[0] - a[0] for a, b in zip(imu_entries, imu_entries[1:])]
+        if any(d < 0 or d > 0xFFFFFFFF for d in deltas):
+            raise ValueError("IMU timestamp deltas must fit in uint32 and be non-decreasing")
+
+        f.write("// Sample i is at kEmbeddedImuT0Ns + sum(kEmbeddedImuDtNs[0..i]); dt[0] = 0.\n")
+        f.write(f"static constexpr int64_t kEmbeddedImuT0Ns = {t0}LL;\n")
+        f.write("static const uint32_t kEmbeddedImuDtNs[] = {\n")
+        write_int_array(f, deltas)
+        f.write("};\n\n")
+
+        columns = [[e[1 + c] for e in imu_entries] for c in range(6)]
+        if fmt == "f32":
+            f.write("// Channels wx, wy, wz (rad/s), ax, ay, az (m/s^2)\n")
+            f.write("alignas(64) static const float kEmbeddedImuChannel[6][kEmbeddedImuCount] = {\n")
+            for name, col in zip(IMU_CHANNELS, columns):
+                f.write(f"  {{ // {name}\n")
+                write_float_array(f, col)
+                f.write("  },\n")
+            f.write("};\n")
+        else:
+            # Per-channel scale so the largest magnitude maps to ±32767.
+            scales = [max(max(abs(v) for v in col), 1e-9) / 32767.0 for col in columns]
+            max_err = [max(abs(round(v / s) * s - v) for v in col) for col, s in zip(columns, scales)]
+            f.write("// Channels wx, wy, wz (rad/s), ax, ay, az (m/s^2); value = q * kEmbeddedImuScale[c]\n")
+            f.write("static constexpr float kEmbeddedImuScale[6] = {"
+                    + ", ".join(f"{s:.9e}f" for s in scales) + "};\n")
+            f.write("// max quantisation error per channel: "
+                    + ", ".join(f"{n}={e:.2e}" for n, e in zip(IMU_CHANNELS, max_err)) + "\n")
+            f.write("alignas(64) static const int16_t kEmbeddedImuChannel[6][kEmbeddedImuCount] = {\n")
+            for name, col, s in zip(IMU_CHANNELS, columns, scales):
+                f.write(f"  {{ // {name}\n")
+                write_int_array(f, [max(-32767, min(32767, round(v / s))) for v in col])
+                f.write("  },\n")
+            f.write("};\n")
+            print("  IMU i16 max quantisation error: "
+                  + ", ".join(f"{n}={e:.2e}" for n, e in zip(IMU_CHANNELS, max_err)))
+
+    bytes_per_sample = {"aos": 56, "f32": 4 + 6 * 4, "i16": 4 + 6 * 2}[fmt]
+    print(f"  IMU layout {fmt}: {bytes_per_sample} B/sample "
+          f"({bytes_per_sample * len(imu_entries) / 1024:.1f} KB, aos would be "
+          f"{56 * len(imu_entries) / 1024:.1f} KB)")
+
+
+def write_int_array(f, values, cols=12):
+    for i in range(0, len(values), cols):
+        f.write("    " + ",".join(str(v) for v in values[i:i + cols]) + ",\n")
+
+
+def write_float_array(f, values, cols=6):
+    for i in range(0, len(values), cols):
+        f.write("    " + ",".join(f"{v:.9e}f" for v in values[i:i + cols]) + ",\n")
 
 
 def write_byte_array(f, data, cols=16):
@@ -159,5 +306,241 @@ def write_byte_array(f, data, cols=16):
         f.write("\n")
 
 
+def align_up(n, a):
+    return (n + a - 1) // a * a
+
+
+# ==============================================================================
+# PNG → GRAY8 (8-bit greyscale, non-interlaced — what EuRoC ships)
+# Pure Python so the script keeps working without Pillow/numpy.
+# ==============================================================================
+
+def decode_png_gray8(png):
+    if png[:8] != b"\x89PNG\r\n\x1a\n":
+        raise ValueError("not a PNG file")
+    pos, idat = 8, []
+    width = height = None
+    while pos < len(png):
+        length, ctype = struct.unpack(">I4s", png[pos:pos + 8])
+        body = png[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if ctype == b"IHDR":
+            width, height, depth, color, _, _, interlace = struct.unpack(">IIBBBBB", body)
+            if depth != 8 or color != 0 or interlace != 0:
+                raise ValueError(f"unsupported PNG (depth={depth} color={color} "
+                                 f"interlace={interlace}); expected 8-bit greyscale")
+        elif ctype == b"IDAT":
+            idat.append(body)
+        elif ctype == b"IEND":
+            break
+
+    raw = zlib.decompress(b"".join(idat))
+    out = bytearray(width * height)
+    prev = bytearray(width)
+    src = 0
+    for y in range(height):
+        ftype = raw[src]
+        line = bytearray(raw[src + 1:src + 1 + width])
+        src += 1 + width
+        if ftype == 1:      # Sub
+            for x in range(1, width):
+                line[x] = (line[x] + line[x - 1]) & 0xFF
+        elif ftype == 2:    # Up
+            line = bytearray((a + b) & 0xFF for a, b in zip(line, prev))
+        elif ftype == 3:    # Average
+            line[0] = (line[0] + (prev[0] >> 1)) & 0xFF
+            for x in range(1, width):
+                line[x] = (line[x] + ((line[x - 1] + prev[x]) >> 1)) & 0xFF
+        elif ftype == 4:    # Paeth
+            line[0] = (line[0] + prev[0]) & 0xFF
+            for x in range(1, width):
+                a, b, c = line[x - 1], prev[x], prev[x - 1]
+                p = a + b - c
+                pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+                pred = a if (pa <= pb and pa <= pc) else (b if pb <= pc else c)
+                line[x] = (line[x] + pred) & 0xFF
+        out[y * width:(y + 1) * width] = line
+        prev = line
+    return width, height, bytes(out)
+
+
+def downscale_box(w, h, pixels, n):
+    """Average n×n blocks (like cv::resize INTER_AREA for an integer factor)."""
+    if n == 1:
+        return w, h, pixels
+    ow, oh = w // n, h // n
+    out = bytearray(ow * oh)
+    area, half = n * n, (n * n) // 2
+    for oy in range(oh):
+        rows = [pixels[(oy * n + k) * w:(oy * n + k) * w + ow * n] for k in range(n)]
+        for ox in range(ow):
+            s = 0
+            for r in rows:
+                s += sum(r[ox * n:ox * n + n])
+            out[oy * ow + ox] = (s + half) // area
+    return ow, oh, bytes(out)
+
+
+def equalize_hist(pixels):
+    """Same LUT as cv::equalizeHist."""
+    hist = [pixels.count(bytes([v])) for v in range(256)]
+    total = len(pixels)
+    i = 0
+    while hist[i] == 0:
+        i += 1
+    if hist[i] == total:
+        return bytes([i]) * total
+    scale = 255.0 / (total - hist[i])
+    lut = [0] * 256
+    s = 0
+    for v in range(i + 1, 256):
+        s += hist[v]
+        lut[v] = min(255, round(s * scale))   # round-half-even, like cvRound
+    return pixels.translate(bytes(lut))
+
+
+def pad_rows(w, h, pixels, stride):
+    if stride == w:
+        return pixels
+    pad = bytes(stride - w)
+    return b"".join(pixels[y * w:(y + 1) * w] + pad for y in range(h))
+
+
+# ==============================================================================
+# LZ4 block format (greedy, 4-byte hash of prefixes). Uses the lz4 package if
+# installed; the pure Python fallback produces a valid but slower-to-build
+# stream. Both decode with lz4_block_decompress() on target.
+# ==============================================================================
+
+def lz4_compress_block(data):
+    try:
+        import lz4.block
+        return lz4.block.compress(data, store_size=False)
+    except ImportError:
+        pass
+
+    n = len(data)
+    out = bytearray()
+    table = {}
+    anchor = i = 0
+    limit = n - 12          # LZ4: last match starts >= 12 bytes before the end
+    while i < limit:
+        key = data[i:i + 4]
+        cand = table.get(key)
+        table[key] = i
+        if cand is None or i - cand > 0xFFFF:
+            i += 1
+            continue
+        m = 4
+        max_m = n - 5 - i   # LZ4: last 5 bytes are always literals
+        while m < max_m and data[cand + m] == data[i + m]:
+            m += 1
+        _lz4_sequence(out, data[anchor:i], i - cand, m)
+        i += m
+        anchor = i
+    _lz4_sequence(out, data[anchor:], 0, 0)
+    return bytes(out)
+
+
+def _lz4_sequence(out, literals, offset, match_len):
+    lit = len(literals)
+    ml = match_len - 4 if match_len else 0
+    out.append((min(lit, 15) << 4) | min(ml, 15))
+    if lit >= 15:
+        _lz4_length(out, lit - 15)
+    out += literals
+    if match_len:
+        out += struct.pack("<H", offset)
+        if ml >= 15:
+            _lz4_length(out, ml - 15)
+
+
+def _lz4_length(out, n):
+    while n >= 255:
+        out.append(255)
+        n -= 255
+    out.append(n)
+
+
+def lz4_decompress_block(src, size):
+    out = bytearray()
+    i = 0
+    while i < len(src):
+        token = src[i]; i += 1
+        lit = token >> 4
+        if lit == 15:
+            while True:
+                b = src[i]; i += 1; lit += b
+                if b != 255: break
+        out += src[i:i + lit]; i += lit
+        if i >= len(src):
+            break
+        off = src[i] | (src[i + 1] << 8); i += 2
+        ml = (token & 0xF) + 4
+        if token & 0xF == 15:
+            while True:
+                b = src[i]; i += 1; ml += b
+                if b != 255: break
+        start = len(out) - off
+        for k in range(ml):
+            out.append(out[start + k])
+    if len(out) != size:
+        raise ValueError("LZ4 round trip size mismatch")
+    return bytes(out)
+
+
+# ==============================================================================
+# SIZE / SPEED REPORT
+# ==============================================================================
+
+class FormatReport:
+    """Image bytes per format, and host decode time of png/lz4 as a relative
+    cost proxy (raw has no decode). The host numbers only rank the formats;
+    offline_cam prints the real per-frame decode time on target."""
+
+    def __init__(self):
+        self.images = 0
+        self.bytes = {"png": 0, "raw": 0, "lz4": 0}
+        self.host_s = {"png": 0.0, "lz4": 0.0}
+
+    def add(self, png, raw, lz4=None):
+        self.images += 1
+        self.bytes["png"] += len(png)
+        self.bytes["raw"] += len(raw)
+
+        t0 = time.perf_counter()
+        decode_png_gray8(png)
+        self.host_s["png"] += time.perf_counter() - t0
+
+        if lz4 is None:
+            lz4 = lz4_compress_block(raw)
+        self.bytes["lz4"] += len(lz4)
+        t0 = time.perf_counter()
+        if lz4_decompress_block(lz4, len(raw)) != raw:
+            raise ValueError("LZ4 round trip mismatch")
+        self.host_s["lz4"] += time.perf_counter() - t0
+
+    def print(self, width, height, args):
+        n = max(self.images, 1)
+        raw_total = max(self.bytes["raw"], 1)
+        target = {
+            "png": "zlib inflate + PNG unfilter (libpng, decode workers)",
+            "raw": "none: zero-copy cv::Mat view into ROM",
+            "lz4": "LZ4 block copy into a pooled Mat",
+        }
+        print(f"\n  ===== camera format report ({self.images} images, {width}x{height}"
+              f"{', equalized' if args.equalize else ''}"
+              f"{f', downscale {args.downscale}x' if args.downscale != 1 else ''}) =====")
+        print(f"  {'format':<6} {'total MB':>9} {'KB/img':>8} {'vs raw':>7} {'host ms/img':>12}  target decode")
+        for fmt in CAM_FORMATS:
+            mark = "*" if fmt == args.cam_format else " "
+            host = f"{self.host_s[fmt] * 1000 / n:12.2f}" if fmt in self.host_s else f"{'-':>12}"
+            print(f"{mark} {fmt:<6} {self.bytes[fmt] / 1024 / 1024:9.2f} "
+                  f"{self.bytes[fmt] / 1024 / n:8.1f} {self.bytes[fmt] / raw_total:7.2f} "
+                  f"{host}  {target[fmt]}")
+        print("  (host ms = pure-Python decode, a relative proxy only; "
+              "offline_cam reports decode us/frame on target)\n")
+
+
 if __name__ == "__main__":
-    main()
\ No newline at end of file
+    main()
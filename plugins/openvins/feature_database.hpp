@@ -0,0 +1,121 @@
+#ifndef OPENVINS_FEATURE_DATABASE_HPP
+#define OPENVINS_FEATURE_DATABASE_HPP
+
+/*
+ * Feature tracks for the MSCKF, stored as structure-of-arrays.
+ *
+ * A track is a run of consecutive frames: a feature that is not found in a
+ * frame is lost and leaves the database. So a track needs no per-observation
+ * keys, only its first and last frame number. Frames are numbered by the
+ * estimator (the frame sequence, not timestamps).
+ *
+ *   dense list   live features at indices 0 .. size()-1. remove() moves the
+ *                last one into the hole, so iteration never skips gaps.
+ *   rings        `window` observation slots per feature, indexed by
+ *                frame % window. A track keeps at most its last `window`
+ *                frames; older ones are overwritten.
+ *
+ * Storage grows to the peak feature count and is then reused, so tracking,
+ * marginalisation and updates allocate nothing per frame.
+ */
+
+#include <Eigen/Dense>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace OpenVINS {
+
+class FeatureDatabase {
+public:
+    // Empties the database. `window` is the longest track kept, in frames;
+    // `capacity` the expected peak number of features (a reservation only).
+    void reset(int window, size_t capacity) {
+        window_ = window > 0 ? window : 1;
+        id_.clear();
+        first_.clear();
+        last_.clear();
+        uv0_.clear();
+        uv1_.clear();
+        id_.reserve(capacity);
+        first_.reserve(capacity);
+        last_.reserve(capacity);
+        uv0_.reserve(capacity * window_);
+        uv1_.reserve(capacity * window_);
+    }
+
+    size_t   size() const { return id_.size(); }
+    size_t   id(size_t i) const { return id_[i]; }
+    uint64_t first(size_t i) const { return first_[i]; }
+    uint64_t last(size_t i) const { return last_[i]; }
+    int      length(size_t i) const { return static_cast<int>(last_[i] - first_[i] + 1); }
+
+    // Normalised cam0 / cam1 observation of feature i in `frame`, which
+    // must lie in [first(i), last(i)].
+    const Eigen::Vector2d& uv0(size_t i, uint64_t frame) const { return uv0_[slot(i, frame)]; }
+    const Eigen::Vector2d& uv1(size_t i, uint64_t frame) const { return uv1_[slot(i, frame)]; }
+
+    // Starts a track seen only in `frame`; returns its index.
+    size_t add(size_t id, uint64_t frame, const Eigen::Vector2d& uv0, const Eigen::Vector2d& uv1) {
+        size_t i = id_.size();
+        id_.push_back(id);
+        first_.push_back(frame);
+        last_.push_back(frame);
+        uv0_.resize(uv0_.size() + window_);
+        uv1_.resize(uv1_.size() + window_);
+        uv0_[slot(i, frame)] = uv0;
+        uv1_[slot(i, frame)] = uv1;
+        return i;
+    }
+
+    // Extends track i by `frame`, which must be last(i) + 1. The oldest
+    // observation is dropped once the track spans `window` frames.
+    void observe(size_t i, uint64_t frame, const Eigen::Vector2d& uv0, const Eigen::Vector2d& uv1) {
+        last_[i] = frame;
+        if (frame - first_[i] >= static_cast<uint64_t>(window_))
+            first_[i] = frame - window_ + 1;
+        uv0_[slot(i, frame)] = uv0;
+        uv1_[slot(i, frame)] = uv1;
+    }
+
+    // Removes feature i; the last feature takes its index.
+    void remove(size_t i) {
+        size_t back = id_.size() - 1;
+        if (i != back) {
+            id_[i]    = id_[back];
+            first_[i] = first_[back];
+            last_[i]  = last_[back];
+            for (int k = 0; k < window_; k++) {
+                uv0_[i * window_ + k] = uv0_[back * window_ + k];
+                uv1_[i * window_ + k] = uv1_[back * window_ + k];
+            }
+        }
+        id_.pop_back();
+        first_.pop_back();
+        last_.pop_back();
+        uv0_.resize(back * window_);
+        uv1_.resize(back * window_);
+    }
+
+    // Forgets every observation before `frame` (the clone window slid past
+    // it). Tracks have all been seen since, so none becomes empty.
+    void drop_before(uint64_t frame) {
+        for (size_t i = 0; i < first_.size(); i++)
+            if (first_[i] < frame) first_[i] = frame;
+    }
+
+private:
+    int window_ = 1;
+    std::vector<size_t>          id_;
+    std::vector<uint64_t>        first_, last_;
+    std::vector<Eigen::Vector2d> uv0_, uv1_;   // size() × window_, ring per feature
+
+    size_t slot(size_t i, uint64_t frame) const {
+        return i * window_ + static_cast<size_t>(frame % window_);
+    }
+};
+
+} // namespace OpenVINS
+
+#endif // OPENVINS_FEATURE_DATABASE_HPP
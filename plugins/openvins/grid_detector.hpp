@@ -0,0 +1,262 @@
+#ifndef OPENVINS_GRID_DETECTOR_HPP
+#define OPENVINS_GRID_DETECTOR_HPP
+
+/*
+ * Grid-bucketed corner detector for the MSCKF front end.
+ *
+ * cv::goodFeaturesToTrack computes the minimum eigenvalue at every pixel of
+ * the frame and needs a full-size mask with a circle per tracked feature.
+ * Re-detection only has to fill the parts of the image that lost their
+ * tracks, so this detector works on two small grids instead:
+ *
+ *   buckets    grid_cols × grid_rows cells with a cap of
+ *              ceil(max_features / cells) features each. Only cells below
+ *              their cap are scanned, so new features go where tracks are
+ *              missing and stay evenly spread.
+ *   occupancy  min_distance px cells, each listing the tracked and accepted
+ *              features inside it. A corner is accepted only when no
+ *              feature in its own or the 8 neighbouring cells is closer than
+ *              min_distance px, the spacing the circle mask enforced. The
+ *              check doubles as non-maximum suppression.
+ *
+ * Candidates are FAST-9 corners (segment test at `threshold`, with the
+ * 0/4/8/12 early reject). Each occupancy cell keeps just its strongest
+ * corner by FAST score, so at most one new feature lands in a cell per
+ * scan; features can still be as close as min_distance across cells. The
+ * survivors are ranked by the Shi-Tomasi minimum eigenvalue over a 7×7
+ * window, computed for them alone. A bucket that yields nothing is scanned
+ * once more at half the threshold, so low-contrast areas are not left
+ * empty.
+ *
+ * Works on raw 8-bit views like NccEngine and LkTracker.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "ncc_engine.hpp"
+
+namespace OpenVINS {
+
+struct Corner {
+    float x, y;
+    float score;   // Shi-Tomasi minimum eigenvalue
+};
+
+class GridDetector {
+public:
+    // Clears both grids for a cols×rows image. `border` keeps corners at
+    // least that far from the edge (at least the NCC template half-size).
+    void reset(int cols, int rows, int grid_cols, int grid_rows, int max_features,
+               int min_distance, int border) {
+        cols_ = cols;
+        rows_ = rows;
+        gcols_ = std::max(1, grid_cols);
+        grows_ = std::max(1, grid_rows);
+        cell_cap_ = (max_features + gcols_ * grows_ - 1) / (gcols_ * grows_);
+        dist_ = std::max(1, min_distance);
+        border_ = std::max(border, kRadius + 1);
+        ocols_ = (cols + dist_ - 1) / dist_;
+        orows_ = (rows + dist_ - 1) / dist_;
+        head_.assign(static_cast<size_t>(ocols_) * orows_, -1);
+        occupants_.clear();
+        slot_.assign(head_.size(), -1);
+        bucket_count_.assign(static_cast<size_t>(gcols_) * grows_, 0);
+    }
+
+    // Marks an existing feature at (x, y): keeps new corners min_distance
+    // away from it and counts it against its bucket's cap.
+    void occupy(float x, float y) {
+        if (!(x >= 0.0f && y >= 0.0f && x < cols_ && y < rows_)) return;
+        int  ix = static_cast<int>(x), iy = static_cast<int>(y);
+        int& h  = head_[static_cast<size_t>(iy / dist_) * ocols_ + ix / dist_];
+        occupants_.push_back({x, y, h});
+        h = static_cast<int>(occupants_.size()) - 1;
+        bucket_count_[bucket_of(ix, iy)]++;
+    }
+
+    // Up to `max_new` new corners in `img`, best of each bucket first.
+    // Accepted corners occupy the grids too.
+    void detect(const GrayView& img, int threshold, int max_new, std::vector<Corner>& out) {
+        out.clear();
+        picked_.clear();
+        if (max_new <= 0) return;
+
+        for (int by = 0; by < grows_; by++) {
+            for (int bx = 0; bx < gcols_; bx++) {
+                int room = cell_cap_ - bucket_count_[static_cast<size_t>(by) * gcols_ + bx];
+                if (room <= 0) continue;
+
+                const int x0 = std::max(border_, bx * cols_ / gcols_);
+                const int x1 = std::min(cols_ - border_, (bx + 1) * cols_ / gcols_);
+                const int y0 = std::max(border_, by * rows_ / grows_);
+                const int y1 = std::min(rows_ - border_, (by + 1) * rows_ / grows_);
+                if (x0 >= x1 || y0 >= y1) continue;
+
+                scan(img, x0, y0, x1, y1, threshold);
+                if (cand_.empty()) scan(img, x0, y0, x1, y1, threshold / 2);
+
+                std::sort(cand_.begin(), cand_.end(),
+                          [](const Corner& a, const Corner& b) { return a.score > b.score; });
+                int rank = 0;
+                for (const Corner& c : cand_) {
+                    if (rank == room) break;
+                    if (!is_free(c.x, c.y)) continue;
+                    occupy(c.x, c.y);
+                    picked_.push_back({rank++, c});
+                }
+            }
+        }
+
+        // Over budget: every bucket's best before any bucket's second, so
+        // the cut keeps the spread; by score within a rank.
+        std::sort(picked_.begin(), picked_.end(),
+                  [](const std::pair<int, Corner>& a, const std::pair<int, Corner>& b) {
+                      return a.first != b.first ? a.first < b.first
+                                                : a.second.score > b.second.score;
+                  });
+        for (const auto& rc : picked_) {
+            if (static_cast<int>(out.size()) == max_new) break;
+            out.push_back(rc.second);
+        }
+    }
+
+private:
+    static constexpr int kRadius = 3;   // FAST circle; the 7×7 score window
+
+    int cols_ = 0, rows_ = 0;
+    int gcols_ = 1, grows_ = 1, cell_cap_ = 0;
+    int dist_ = 1, border_ = kRadius + 1;
+    int ocols_ = 0, orows_ = 0;
+
+    // Features per occupancy cell, as singly linked lists through occupants_.
+    struct Occupant {
+        float x, y;
+        int   next;   // index in occupants_, or -1
+    };
+    std::vector<int>      head_;        // occupancy cell → first occupant, or -1
+    std::vector<Occupant> occupants_;
+    std::vector<int>     bucket_count_;
+    std::vector<Corner>  cand_;         // per-bucket scratch
+    std::vector<int>     slot_;         // occupancy cell → its candidate in cand_, or -1
+    std::vector<std::pair<int, Corner>> picked_;   // (rank in bucket, corner)
+
+    size_t bucket_of(int x, int y) const {
+        int bx = std::min(gcols_ - 1, x * gcols_ / cols_);
+        int by = std::min(grows_ - 1, y * grows_ / rows_);
+        return static_cast<size_t>(by) * gcols_ + bx;
+    }
+
+    // No feature closer than min_distance. Cells are min_distance wide, so
+    // any such feature lies in the 3×3 cells around (x, y).
+    bool is_free(float x, float y) const {
+        const int   ox = static_cast<int>(x) / dist_, oy = static_cast<int>(y) / dist_;
+        const float d2 = static_cast<float>(dist_) * dist_;
+        for (int j = std::max(0, oy - 1); j <= std::min(orows_ - 1, oy + 1); j++) {
+            for (int i = std::max(0, ox - 1); i <= std::min(ocols_ - 1, ox + 1); i++) {
+                for (int k = head_[static_cast<size_t>(j) * ocols_ + i]; k >= 0;
+                     k = occupants_[static_cast<size_t>(k)].next) {
+                    const Occupant& o  = occupants_[static_cast<size_t>(k)];
+                    const float     dx = o.x - x, dy = o.y - y;
+                    if (dx * dx + dy * dy < d2) return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    // The strongest FAST-9 corner of each occupancy cell in [x0, x1) ×
+    // [y0, y1) whose neighbourhood is still free, scored by min_eigen.
+    void scan(const GrayView& img, int x0, int y0, int x1, int y1, int threshold) {
+        cand_.clear();
+        if (threshold < 1) threshold = 1;
+        const int s = static_cast<int>(img.step);
+        const int circle[16] = {
+            -3 * s,     -3 * s + 1, -2 * s + 2, -s + 3,
+            3,          s + 3,      2 * s + 2,  3 * s + 1,
+            3 * s,      3 * s - 1,  2 * s - 2,  s - 3,
+            -3,         -s - 3,     -2 * s - 2, -3 * s - 1,
+        };
+
+        for (int y = y0; y < y1; y++) {
+            const uint8_t* p = img.row(y);
+            for (int x = x0; x < x1; x++) {
+                const uint8_t* c = p + x;
+                const int hi = *c + threshold, lo = *c - threshold;
+
+                // Any 9-pixel arc covers one of 0/8 and one of 4/12.
+                auto bright = [&](int i) { return c[circle[i]] > hi; };
+                auto dark   = [&](int i) { return c[circle[i]] < lo; };
+                bool may_b = (bright(0) || bright(8)) && (bright(4) || bright(12));
+                bool may_d = (dark(0) || dark(8)) && (dark(4) || dark(12));
+                if (!may_b && !may_d) continue;
+
+                uint32_t mb = 0, md = 0;
+                for (int i = 0; i < 16; i++) {
+                    int v = c[circle[i]];
+                    mb |= static_cast<uint32_t>(v > hi) << i;
+                    md |= static_cast<uint32_t>(v < lo) << i;
+                }
+                if (!arc9(mb) && !arc9(md)) continue;
+                if (!is_free(static_cast<float>(x), static_cast<float>(y))) continue;
+
+                // FAST score: summed contrast beyond the threshold.
+                int fs = 0;
+                for (int i = 0; i < 16; i++) {
+                    int d = std::abs(c[circle[i]] - *c) - threshold;
+                    if (d > 0) fs += d;
+                }
+                int& k = slot_[static_cast<size_t>(y / dist_) * ocols_ + x / dist_];
+                Corner corner{static_cast<float>(x), static_cast<float>(y),
+                              static_cast<float>(fs)};
+                if (k < 0) {
+                    k = static_cast<int>(cand_.size());
+                    cand_.push_back(corner);
+                } else if (corner.score > cand_[static_cast<size_t>(k)].score) {
+                    cand_[static_cast<size_t>(k)] = corner;
+                }
+            }
+        }
+
+        for (Corner& c : cand_) {
+            const int x = static_cast<int>(c.x), y = static_cast<int>(c.y);
+            slot_[static_cast<size_t>(y / dist_) * ocols_ + x / dist_] = -1;
+            c.score = min_eigen(img, x, y);
+        }
+    }
+
+    // True if the 16-bit ring mask has 9 consecutive set bits (with wrap).
+    static bool arc9(uint32_t m) {
+        m |= m << 16;
+        uint32_t run = m;
+        for (int i = 1; i < 9; i++) run &= m >> i;
+        return run != 0;
+    }
+
+    // Shi-Tomasi score: smaller eigenvalue of the 7×7 structure tensor of
+    // central-difference gradients.
+    static float min_eigen(const GrayView& img, int x, int y) {
+        float a = 0, b = 0, c = 0;
+        for (int dy = -kRadius; dy <= kRadius; dy++) {
+            const uint8_t* r  = img.row(y + dy) + x;
+            const uint8_t* up = img.row(y + dy - 1) + x;
+            const uint8_t* dn = img.row(y + dy + 1) + x;
+            for (int dx = -kRadius; dx <= kRadius; dx++) {
+                float gx = 0.5f * (r[dx + 1] - r[dx - 1]);
+                float gy = 0.5f * (dn[dx] - up[dx]);
+                a += gx * gx;
+                b += gx * gy;
+                c += gy * gy;
+            }
+        }
+        float h = 0.5f * (a - c);
+        return 0.5f * (a + c) - std::sqrt(h * h + b * b);
+    }
+};
+
+} // namespace OpenVINS
+
+#endif // OPENVINS_GRID_DETECTOR_HPP
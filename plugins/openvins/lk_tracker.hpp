@@ -0,0 +1,157 @@
+#ifndef OPENVINS_LK_TRACKER_HPP
+#define OPENVINS_LK_TRACKER_HPP
+
+/*
+ * Inverse-compositional Lucas-Kanade point tracker (translation only).
+ *
+ * cv::video is not built, so this is the KLT the template search replaced,
+ * written against the same raw 8-bit views as NccEngine. Per pyramid level:
+ *
+ *   template   window×window patch around the feature in the previous
+ *              image, bilinearly sampled at its sub-pixel position, with its
+ *              central-difference gradients and the 2×2 Hessian Σ∇T∇Tᵀ,
+ *              inverted once
+ *   iteration  sample the current image at the warped window, one Σ∇T·e
+ *              accumulation and a 2×2 multiply, d ← d − Δ
+ *
+ * The displacement is doubled from level to level, coarsest first, and the
+ * result is sub-pixel. A track is accepted when the final patch still
+ * correlates (zero-mean NCC) with the template at `min_ncc`, the same test
+ * the NCC trackers apply.
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "ncc_engine.hpp"
+
+namespace OpenVINS {
+
+class LkTracker {
+public:
+    // Tracks (px, py) in levels[0] of `prev` to `curr`, starting from the
+    // full-resolution guess (gx, gy). `prev` and `curr` hold `levels` views,
+    // each half the size of the one before. Returns false when the feature
+    // leaves the image, the template is textureless, or the final NCC is
+    // below min_ncc.
+    bool track(const GrayView* prev, const GrayView* curr, int levels,
+               float px, float py, float gx, float gy,
+               int window, int max_iterations, float epsilon, double min_ncc,
+               float& out_x, float& out_y) {
+        const size_t n = static_cast<size_t>(window) * window;
+        t_.resize(n);
+        tx_.resize(n);
+        ty_.resize(n);
+        warped_.resize(n);
+        grad_src_.resize(static_cast<size_t>(window + 2) * (window + 2));
+
+        float dx = gx - px, dy = gy - py;   // displacement at full resolution
+        const float half = 0.5f * (window - 1);
+
+        for (int l = levels - 1; l >= 0; l--) {
+            const float scale = std::ldexp(1.0f, -l);
+            const float cx = px * scale, cy = py * scale;
+            float ldx = dx * scale, ldy = dy * scale;
+
+            // Template, gradients and inverse Hessian at this level.
+            if (!sample(prev[l], cx - half - 1, cy - half - 1, window + 2, grad_src_.data())) {
+                if (l == 0) return false;
+                continue;   // too close to the border for this level
+            }
+            float h_xx = 0, h_xy = 0, h_yy = 0;
+            const int gs = window + 2;
+            for (int r = 0; r < window; r++) {
+                const float* row = &grad_src_[static_cast<size_t>(r + 1) * gs + 1];
+                for (int c = 0; c < window; c++) {
+                    size_t i = static_cast<size_t>(r) * window + c;
+                    t_[i]  = row[c];
+                    tx_[i] = 0.5f * (row[c + 1] - row[c - 1]);
+                    ty_[i] = 0.5f * (row[c + gs] - row[c - gs]);
+                    h_xx += tx_[i] * tx_[i];
+                    h_xy += tx_[i] * ty_[i];
+                    h_yy += ty_[i] * ty_[i];
+                }
+            }
+            float det = h_xx * h_yy - h_xy * h_xy;
+            if (det < 1e-6f * (h_xx + h_yy) * (h_xx + h_yy) || det <= 0.0f) {
+                if (l == 0) return false;
+                continue;
+            }
+            const float i_xx = h_yy / det, i_xy = -h_xy / det, i_yy = h_xx / det;
+
+            bool inside = true;
+            for (int it = 0; it < max_iterations; it++) {
+                if (!sample(curr[l], cx + ldx - half, cy + ldy - half, window, warped_.data())) {
+                    inside = false;
+                    break;
+                }
+                float b_x = 0, b_y = 0;
+                for (size_t i = 0; i < n; i++) {
+                    float e = warped_[i] - t_[i];
+                    b_x += tx_[i] * e;
+                    b_y += ty_[i] * e;
+                }
+                float step_x = i_xx * b_x + i_xy * b_y;
+                float step_y = i_xy * b_x + i_yy * b_y;
+                ldx -= step_x;
+                ldy -= step_y;
+                if (step_x * step_x + step_y * step_y < epsilon * epsilon) break;
+            }
+            if (!inside) {
+                if (l == 0) return false;
+                continue;   // keep the estimate from the coarser level
+            }
+            dx = ldx / scale;
+            dy = ldy / scale;
+        }
+
+        out_x = px + dx;
+        out_y = py + dy;
+        if (!sample(curr[0], out_x - half, out_y - half, window, warped_.data())) return false;
+        return ncc() >= min_ncc;
+    }
+
+private:
+    std::vector<float> t_, tx_, ty_, warped_, grad_src_;
+
+    // Bilinear size×size patch with top-left sample at (x0, y0). One set of
+    // weights serves the whole patch. False if any tap is outside the image.
+    static bool sample(const GrayView& img, float x0, float y0, int size, float* out) {
+        if (!(x0 >= 0.0f && y0 >= 0.0f)) return false;
+        const int ix = static_cast<int>(x0), iy = static_cast<int>(y0);
+        if (ix + size >= img.cols || iy + size >= img.rows) return false;
+
+        const float fx = x0 - ix, fy = y0 - iy;
+        const float w00 = (1 - fx) * (1 - fy), w01 = fx * (1 - fy);
+        const float w10 = (1 - fx) * fy,       w11 = fx * fy;
+        for (int r = 0; r < size; r++) {
+            const uint8_t* a = img.row(iy + r) + ix;
+            const uint8_t* b = img.row(iy + r + 1) + ix;
+            for (int c = 0; c < size; c++)
+                *out++ = w00 * a[c] + w01 * a[c + 1] + w10 * b[c] + w11 * b[c + 1];
+        }
+        return true;
+    }
+
+    // Zero-mean NCC of the template against the last warped patch.
+    double ncc() const {
+        const size_t n = t_.size();
+        double s_t = 0, s_w = 0;
+        for (size_t i = 0; i < n; i++) { s_t += t_[i]; s_w += warped_[i]; }
+        const double m_t = s_t / n, m_w = s_w / n;
+        double s_tw = 0, s_tt = 0, s_ww = 0;
+        for (size_t i = 0; i < n; i++) {
+            double a = t_[i] - m_t, b = warped_[i] - m_w;
+            s_tw += a * b;
+            s_tt += a * a;
+            s_ww += b * b;
+        }
+        if (s_tt < 1e-6 || s_ww < 1e-6) return -1.0;
+        return s_tw / std::sqrt(s_tt * s_ww);
+    }
+};
+
+} // namespace OpenVINS
+
+#endif // OPENVINS_LK_TRACKER_HPP
@@ -0,0 +1,220 @@
+#ifndef OPENVINS_NCC_ENGINE_HPP
+#define OPENVINS_NCC_ENGINE_HPP
+
+/*
+ * NCC template search for the MSCKF front end.
+ *
+ * ncc_match() recomputes all five sums of a template pair per candidate. A
+ * search only ever moves the target patch, so the engine splits the work:
+ *
+ *   template   copied once; ΣT and n·ΣT² − (ΣT)² computed once
+ *   region     integral images of I and I² over the bounding box of the
+ *              candidate centres, so ΣI and ΣI² are four lookups each
+ *   candidate  only ΣT·I, in integers (u8·u8 accumulated in u32)
+ *
+ * The score is the same normalised cross-correlation as ncc_match():
+ *
+ *   (n·ΣTI − ΣT·ΣI) / sqrt((n·ΣT² − (ΣT)²) · (n·ΣI² − (ΣI)²))
+ *
+ * with every numerator exact in int64, and -1 for flat patches (ncc_match's
+ * var < 1e-6 is var == 0 for 8-bit data and templates up to 1000 px wide).
+ * Searches visit candidates in ncc_match order (dy outer, dx inner, strict
+ * '>'), so the best position is the one the per-candidate loop picked.
+ *
+ * Works on raw 8-bit views so it carries no OpenCV dependency; SLAMMath.hpp
+ * wraps cv::Mat, and bench/ncc_bench.cpp times it on the host. The patch
+ * loops themselves are NccKernels (ncc_kernels.hpp): scalar, or RVV.
+ * Their prepare_hart hook runs once per set_template() / prepare(), after
+ * the step's last allocation, so nothing blocks between it and the kernels.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "ncc_kernels.hpp"
+
+namespace OpenVINS {
+
+// Row-major 8-bit image; `step` is the row pitch in bytes (cv::Mat::step).
+struct GrayView {
+    const uint8_t* data;
+    int            cols;
+    int            rows;
+    size_t         step;
+
+    const uint8_t* row(int y) const { return data + static_cast<size_t>(y) * step; }
+};
+
+class NccEngine {
+public:
+    explicit NccEngine(const NccKernels& kernels = ncc_kernels())
+        : k_{&kernels}, size_{0}, half_{0}, n_{0}, t_sum_{0}, t_norm_{0},
+          cx_lo_{0}, cy_lo_{0}, cx_hi_{-1}, cy_hi_{-1}, w_{0}, img_{} { }
+
+    const NccKernels& kernels() const { return *k_; }
+
+    // Copies the size×size patch centred at (x, y) with ncc_match's bounds.
+    // False if the patch leaves the image or is flat: every score would be -1.
+    bool set_template(const GrayView& img, int x, int y, int size) {
+        size_ = size;
+        half_ = size / 2;
+        n_    = size * size;
+        if (!patch_inside(img, x, y)) return false;
+
+        const uint8_t* src = img.row(y - half_) + (x - half_);
+        templ_.resize(static_cast<size_t>(n_));
+        for (int r = 0; r < size_; r++)
+            std::memcpy(&templ_[static_cast<size_t>(r) * size_], src + r * img.step, size_);
+
+        if (k_->prepare_hart) k_->prepare_hart();
+        uint32_t sum, sum_sq;
+        k_->patch_sums(templ_.data(), size_, size_, sum, sum_sq);
+        t_sum_  = sum;
+        t_norm_ = n_ * static_cast<int64_t>(sum_sq) - t_sum_ * t_sum_;
+        return t_norm_ > 0;
+    }
+
+    // Builds the integral images for candidate centres in [x_lo, x_hi] ×
+    // [y_lo, y_hi], clipped to centres whose patch lies inside `img`.
+    // False if no candidate survives the clip.
+    bool prepare(const GrayView& img, int x_lo, int y_lo, int x_hi, int y_hi) {
+        img_   = img;
+        cx_lo_ = std::max(x_lo, half_);
+        cy_lo_ = std::max(y_lo, half_);
+        cx_hi_ = std::min(x_hi, img.cols - 1 - half_);
+        cy_hi_ = std::min(y_hi, img.rows - 1 - half_);
+        if (cx_lo_ > cx_hi_ || cy_lo_ > cy_hi_) return false;
+
+        // Pixels covered by every candidate patch, plus a zero row/column.
+        int px0 = cx_lo_ - half_, py0 = cy_lo_ - half_;
+        w_      = cx_hi_ - cx_lo_ + size_ + 1;
+        int h   = cy_hi_ - cy_lo_ + size_ + 1;
+        sum_.assign(static_cast<size_t>(w_) * h, 0);
+        sq_.assign(static_cast<size_t>(w_) * h, 0);
+
+        // u32 is enough for the squares too: the integral may wrap, but a
+        // patch's ΣI² (≤ n·255²) does not, and the box difference is mod 2^32.
+        for (int r = 1; r < h; r++) {
+            const uint8_t* src = img.row(py0 + r - 1) + px0;
+            const size_t   up  = static_cast<size_t>(r - 1) * w_;
+            const size_t   cur = static_cast<size_t>(r) * w_;
+            uint32_t row_sum = 0, row_sq = 0;
+            for (int c = 1; c < w_; c++) {
+                uint32_t v = src[c - 1];
+                row_sum += v;
+                row_sq  += v * v;
+                sum_[cur + c] = sum_[up + c] + row_sum;
+                sq_[cur + c]  = sq_[up + c]  + row_sq;
+            }
+        }
+        if (k_->prepare_hart) k_->prepare_hart();   // for score()
+        return true;
+    }
+
+    bool contains(int x, int y) const {
+        return x >= cx_lo_ && x <= cx_hi_ && y >= cy_lo_ && y <= cy_hi_;
+    }
+
+    // NCC of the template against the patch centred at (x, y); -1 outside
+    // the prepared range or for a flat patch, as ncc_match().
+    double score(int x, int y) const {
+        if (!contains(x, y)) return -1.0;
+
+        const size_t top = static_cast<size_t>(y - cy_lo_) * w_ + (x - cx_lo_);
+        const size_t bot = top + static_cast<size_t>(size_) * w_;
+        const int64_t s_i  = box(sum_, top, bot);
+        const int64_t s_ii = box(sq_,  top, bot);
+        const int64_t i_norm = n_ * s_ii - s_i * s_i;
+        if (i_norm <= 0) return -1.0;
+
+        uint32_t s_ti = k_->patch_dot(templ_.data(), img_.row(y - half_) + (x - half_),
+                                      img_.step, size_);
+
+        const int64_t num = n_ * static_cast<int64_t>(s_ti) - t_sum_ * s_i;
+        return static_cast<double>(num) /
+               std::sqrt(static_cast<double>(t_norm_) * static_cast<double>(i_norm));
+    }
+
+    int cx_lo() const { return cx_lo_; }
+    int cy_lo() const { return cy_lo_; }
+    int cx_hi() const { return cx_hi_; }
+    int cy_hi() const { return cy_hi_; }
+
+private:
+    const NccKernels* k_;
+    int     size_, half_, n_;
+    int64_t t_sum_, t_norm_;
+    std::vector<uint8_t> templ_;
+
+    int      cx_lo_, cy_lo_, cx_hi_, cy_hi_;
+    int      w_;                       // integral row length
+    GrayView img_;
+    std::vector<uint32_t> sum_, sq_;   // buffers reused across searches
+
+    bool patch_inside(const GrayView& img, int x, int y) const {
+        return x - half_ >= 0 && x + half_ < img.cols &&
+               y - half_ >= 0 && y + half_ < img.rows;
+    }
+
+    int64_t box(const std::vector<uint32_t>& ii, size_t top, size_t bot) const {
+        return static_cast<uint32_t>(ii[bot + size_] - ii[bot] - ii[top + size_] + ii[top]);
+    }
+};
+
+// Exhaustive search of the (2r+1)² window around (cx, cy) in `curr` for the
+// template centred at (tx, ty) in `prev`. Returns the best score (-1 when no
+// candidate is valid, with the best position left at (cx, cy)).
+inline double ncc_search_window(NccEngine& ncc, const GrayView& prev, const GrayView& curr,
+                                int tx, int ty, int cx, int cy, int template_size, int radius,
+                                int& best_x, int& best_y) {
+    best_x = cx;
+    best_y = cy;
+    if (!ncc.set_template(prev, tx, ty, template_size)) return -1.0;
+    if (!ncc.prepare(curr, cx - radius, cy - radius, cx + radius, cy + radius)) return -1.0;
+
+    double best_score = -1.0;
+    for (int y = ncc.cy_lo(); y <= ncc.cy_hi(); y++) {
+        for (int x = ncc.cx_lo(); x <= ncc.cx_hi(); x++) {
+            double score = ncc.score(x, y);
+            if (score > best_score) {
+                best_score = score;
+                best_x = x;
+                best_y = y;
+            }
+        }
+    }
+    return best_score;
+}
+
+// Window centred on the template position (frame-to-frame box search).
+inline double ncc_search_window(NccEngine& ncc, const GrayView& prev, const GrayView& curr,
+                                int x0, int y0, int template_size, int radius,
+                                int& best_x, int& best_y) {
+    return ncc_search_window(ncc, prev, curr, x0, y0, x0, y0, template_size, radius,
+                             best_x, best_y);
+}
+
+// Vertex of the parabola through the scores at offsets -1, 0, +1, clamped
+// to ±0.5; 0 when the three do not form a peak or a neighbour is invalid.
+inline double ncc_parabola_peak(double s_m, double s_0, double s_p) {
+    double den = s_m - 2.0 * s_0 + s_p;
+    if (den >= 0.0 || s_m <= -1.0 || s_p <= -1.0) return 0.0;
+    return std::max(-0.5, std::min(0.5, 0.5 * (s_m - s_p) / den));
+}
+
+// Sub-pixel peak around the integer best (x, y) of the last search: a
+// parabola per axis through the peak and its four neighbours (separable
+// fit; four extra score() calls). The engine must still hold that search.
+inline void ncc_refine_subpixel(const NccEngine& ncc, int x, int y, double& sx, double& sy) {
+    double s_0 = ncc.score(x, y);
+    sx = x + ncc_parabola_peak(ncc.score(x - 1, y), s_0, ncc.score(x + 1, y));
+    sy = y + ncc_parabola_peak(ncc.score(x, y - 1), s_0, ncc.score(x, y + 1));
+}
+
+} // namespace OpenVINS
+
+#endif // OPENVINS_NCC_ENGINE_HPP
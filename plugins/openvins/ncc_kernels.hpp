@@ -0,0 +1,96 @@
+#ifndef OPENVINS_NCC_KERNELS_HPP
+#define OPENVINS_NCC_KERNELS_HPP
+
+/*
+ * Patch kernels behind NccEngine: template sums once per search, the
+ * template·patch cross term once per candidate. All integer, u8 products
+ * accumulated in u32, so every implementation returns identical values.
+ *
+ *   scalar  portable C++, always available
+ *   rvv     RVV 1.0 intrinsics (ncc_kernels_rvv.cpp), u8 → u16 → u32
+ *           widening. Built with -DILLIXR_RVV=ON on RISC-V boards and used
+ *           when the hart reports V in misa (spike --isa=rv64gcv); other
+ *           harts fall back to scalar at run time.
+ *
+ * Kernels with a prepare_hart hook (rvv) keep vector registers, which Zephyr
+ * does not save on a context switch: the calling thread must be pinned to
+ * one hart (threadloop::pin_to_cpu), and NccEngine calls the hook once per
+ * search step, never per patch.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+namespace OpenVINS {
+
+struct NccKernels {
+    const char* name;
+
+    // ΣP and ΣP² over the size×size patch at `p` (row pitch `step`).
+    void (*patch_sums)(const uint8_t* p, size_t step, int size,
+                       uint32_t& sum, uint32_t& sum_sq);
+
+    // ΣT·P; `t` is a contiguous size×size template, `p` a patch with pitch `step`.
+    uint32_t (*patch_dot)(const uint8_t* t, const uint8_t* p, size_t step, int size);
+
+    // Makes the kernels runnable on the current hart until the thread next
+    // blocks; nullptr when there is nothing to do.
+    void (*prepare_hart)();
+};
+
+namespace ncc_scalar {
+
+inline void patch_sums(const uint8_t* p, size_t step, int size,
+                       uint32_t& sum, uint32_t& sum_sq) {
+    uint32_t s = 0, sq = 0;
+    for (int r = 0; r < size; r++, p += step) {
+        for (int c = 0; c < size; c++) {
+            uint32_t v = p[c];
+            s  += v;
+            sq += v * v;
+        }
+    }
+    sum    = s;
+    sum_sq = sq;
+}
+
+inline uint32_t patch_dot(const uint8_t* t, const uint8_t* p, size_t step, int size) {
+    uint32_t acc = 0;
+    for (int r = 0; r < size; r++, t += size, p += step)
+        for (int c = 0; c < size; c++) acc += static_cast<uint32_t>(t[c]) * p[c];
+    return acc;
+}
+
+} // namespace ncc_scalar
+
+inline const NccKernels& ncc_scalar_kernels() {
+    static const NccKernels k{"scalar", ncc_scalar::patch_sums, ncc_scalar::patch_dot,
+                              nullptr};
+    return k;
+}
+
+#ifdef ILLIXR_NCC_RVV
+namespace ncc_rvv {
+
+// ncc_kernels_rvv.cpp, the only file built with V.
+void     patch_sums(const uint8_t* p, size_t step, int size, uint32_t& sum, uint32_t& sum_sq);
+uint32_t patch_dot(const uint8_t* t, const uint8_t* p, size_t step, int size);
+
+} // namespace ncc_rvv
+
+// ncc_rvv_hart.cpp; nullptr when the hart has no V extension.
+const NccKernels* ncc_rvv_kernels();
+#endif
+
+// Best implementation for this build and hart, chosen on first use.
+inline const NccKernels& ncc_kernels() {
+#ifdef ILLIXR_NCC_RVV
+    static const NccKernels* k = ncc_rvv_kernels();
+    if (k) return *k;
+#endif
+    return ncc_scalar_kernels();
+}
+
+} // namespace OpenVINS
+
+#endif // OPENVINS_NCC_KERNELS_HPP
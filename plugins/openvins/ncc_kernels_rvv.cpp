@@ -0,0 +1,74 @@
+/*
+ * RVV 1.0 NCC kernels (see ncc_kernels.hpp). This is the only file built
+ * with V in -march (ILLIXR_RVV_MARCH), and it holds nothing but the kernels.
+ * VS is enabled by ncc_rvv_hart.cpp (built without V) before the first
+ * vector instruction, on the hart the calling thread is pinned to. No vector
+ * state is kept between calls.
+ *
+ * Pixels are loaded as u8 (LMUL=1), widened to u16 by vwmulu / vzext and
+ * accumulated per lane into u32 (LMUL=4) with vwaddu.wv; one reduction per
+ * patch at the end. Tail-undisturbed adds keep lanes past a short final
+ * chunk intact. At VLEN=128 a 15 px template row is a single strip.
+ */
+
+#include "ncc_kernels.hpp"
+
+#include <riscv_vector.h>
+
+namespace OpenVINS {
+namespace {
+
+uint32_t reduce(vuint32m4_t acc, size_t vlmax) {
+    vuint32m1_t zero = __riscv_vmv_s_x_u32m1(0, 1);
+    return __riscv_vmv_x_s_u32m1_u32(__riscv_vredsum_vs_u32m4_u32m1(acc, zero, vlmax));
+}
+
+} // namespace
+
+namespace ncc_rvv {
+
+void patch_sums(const uint8_t* p, size_t step, int size,
+                uint32_t& sum, uint32_t& sum_sq) {
+    const size_t vlmax = __riscv_vsetvlmax_e8m1();
+    vuint32m4_t  s     = __riscv_vmv_v_x_u32m4(0, vlmax);
+    vuint32m4_t  sq    = __riscv_vmv_v_x_u32m4(0, vlmax);
+
+    for (int r = 0; r < size; r++, p += step) {
+        size_t left = static_cast<size_t>(size);
+        for (const uint8_t* q = p; left > 0; ) {
+            size_t      vl = __riscv_vsetvl_e8m1(left);
+            vuint8m1_t  v  = __riscv_vle8_v_u8m1(q, vl);
+            vuint16m2_t w  = __riscv_vzext_vf2_u16m2(v, vl);
+            vuint16m2_t w2 = __riscv_vwmulu_vv_u16m2(v, v, vl);
+            s  = __riscv_vwaddu_wv_u32m4_tu(s,  s,  w,  vl);
+            sq = __riscv_vwaddu_wv_u32m4_tu(sq, sq, w2, vl);
+            q    += vl;
+            left -= vl;
+        }
+    }
+    sum    = reduce(s,  vlmax);
+    sum_sq = reduce(sq, vlmax);
+}
+
+uint32_t patch_dot(const uint8_t* t, const uint8_t* p, size_t step, int size) {
+    const size_t vlmax = __riscv_vsetvlmax_e8m1();
+    vuint32m4_t  acc   = __riscv_vmv_v_x_u32m4(0, vlmax);
+
+    for (int r = 0; r < size; r++, t += size, p += step) {
+        size_t left = static_cast<size_t>(size);
+        for (size_t c = 0; left > 0; ) {
+            size_t      vl   = __riscv_vsetvl_e8m1(left);
+            vuint8m1_t  a    = __riscv_vle8_v_u8m1(t + c, vl);
+            vuint8m1_t  b    = __riscv_vle8_v_u8m1(p + c, vl);
+            vuint16m2_t prod = __riscv_vwmulu_vv_u16m2(a, b, vl);
+            acc = __riscv_vwaddu_wv_u32m4_tu(acc, acc, prod, vl);
+            c    += vl;
+            left -= vl;
+        }
+    }
+    return reduce(acc, vlmax);
+}
+
+} // namespace ncc_rvv
+
+} // namespace OpenVINS
@@ -0,0 +1,54 @@
+/*
+ * Hart setup and dispatch for the RVV NCC kernels (ncc_kernels_rvv.cpp).
+ * Built without V on purpose: in a V translation unit the compiler may
+ * schedule vsetvli / vmv ahead of an inline csrs, so VS is enabled here, in
+ * an out-of-line call that returns before any kernel runs.
+ *
+ * Zephyr does not save vector registers on a context switch, so the thread
+ * that runs the kernels is pinned to one hart (openvins, see its plugin).
+ * Nothing else uses V, and ISRs are never built with it, so the registers
+ * survive preemption there. An interrupt returns to the thread with the
+ * mstatus it saved, VS included; a thread that blocks may come back with VS
+ * Off (the initial mstatus of other threads has it Off). NccEngine therefore
+ * calls prepare_hart() after each step that can allocate, and never per
+ * patch.
+ */
+
+#include "ncc_kernels.hpp"
+
+#ifdef __ZEPHYR__
+#include <zephyr/arch/riscv/csr.h>
+#endif
+
+namespace OpenVINS {
+namespace {
+
+constexpr unsigned long kMisaV         = 1UL << ('V' - 'A');
+constexpr unsigned long kMstatusVsInit = 1UL << 9;   // mstatus.VS = Initial
+
+void prepare_hart() {
+#ifdef __ZEPHYR__
+    csr_set(mstatus, kMstatusVsInit);
+#endif
+}
+
+bool hart_has_v() {
+#ifdef __ZEPHYR__
+    return (csr_read(misa) & kMisaV) != 0;
+#else
+    // Hosted (Linux / pk): the binary was built for V, so the loader's
+    // platform has it and has enabled VS.
+    (void)kMisaV;
+    (void)kMstatusVsInit;
+    return true;
+#endif
+}
+
+} // namespace
+
+const NccKernels* ncc_rvv_kernels() {
+    static const NccKernels k{"rvv", ncc_rvv::patch_sums, ncc_rvv::patch_dot, prepare_hart};
+    return hart_has_v() ? &k : nullptr;
+}
+
+} // namespace OpenVINS
@@ -0,0 +1,165 @@
+#!/usr/bin/env python3
+"""
+pack_euroc_data.py
+
+Packs a EuRoC MAV sequence into one .illixrpack file (format documented in
+src/helper/illixrpack.hpp) for offline_imu / offline_cam to stream, instead of
+compiling the data into embedded_*.hpp headers.
+
+Usage:
+  python3 pack_euroc_data.py <euroc_mav0_dir> <output.illixrpack>
+                             [--num-frames N] [--cam-encoding png|raw]
+                             [--lz4] [--imu-chunk N]
+
+  --cam-encoding png  store the PNG files as-is (default, smallest)
+  --cam-encoding raw  store decoded GRAY8 pixels (no PNG decode on target)
+  --lz4               LZ4-compress raw images and IMU chunks
+  --imu-chunk N       IMU / ground-truth samples per chunk (default 256)
+
+state_groundtruth_estimate0/data.csv is packed too when the sequence has it
+(position + orientation only), for the native ground_truth service.
+
+Build with it (see CMakeLists.txt):
+  west build ... -DILLIXR_DATASET_PACK=<output.illixrpack>
+  west build ... -DILLIXR_DATASET_PACK_FS_PATH=/lfs/V1_02_medium.illixrpack
+"""
+
+import argparse
+import csv
+import os
+import struct
+import sys
+
+from embed_euroc_data import decode_png_gray8, lz4_compress_block
+
+MAGIC        = b"ILXPACK1"
+VERSION      = 1
+HEADER_FMT   = "<8sIIQIIII"       # 40 bytes
+ENTRY_FMT    = "<BBHIQIIqq"       # 40 bytes
+IMU_FMT      = "<q3f3f"           # 32 bytes
+GT_FMT       = "<q3f4fI"          # 40 bytes
+CHUNK_ALIGN  = 64
+
+STREAM_IMU, STREAM_CAM0, STREAM_CAM1, STREAM_GT = 0, 1, 2, 3
+CODEC_NONE, CODEC_LZ4 = 0, 1
+CAM_PNG, CAM_RAW = 0, 1
+
+
+def read_csv(path):
+    rows = []
+    with open(path, "r") as f:
+        for row in csv.reader(f):
+            if row and not row[0].startswith("#"):
+                rows.append(row)
+    return rows
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Pack a EuRoC sequence into .illixrpack")
+    parser.add_argument("mav0_dir")
+    parser.add_argument("output")
+    parser.add_argument("--num-frames", type=int, default=0,
+                        help="stereo frames to pack (default: all)")
+    parser.add_argument("--cam-encoding", choices=["png", "raw"], default="png")
+    parser.add_argument("--lz4", action="store_true",
+                        help="LZ4-compress raw images and IMU chunks")
+    parser.add_argument("--imu-chunk", type=int, default=256)
+    args = parser.parse_args()
+
+    cam0 = [(int(r[0]), r[1].strip()) for r in read_csv(os.path.join(args.mav0_dir, "cam0", "data.csv"))]
+    cam1 = [(int(r[0]), r[1].strip()) for r in read_csv(os.path.join(args.mav0_dir, "cam1", "data.csv"))]
+    if args.num_frames > 0:
+        cam0, cam1 = cam0[:args.num_frames], cam1[:args.num_frames]
+    frames = min(len(cam0), len(cam1))
+    cam0, cam1 = cam0[:frames], cam1[:frames]
+
+    imu = [(int(r[0]), *map(float, r[1:7]))
+           for r in read_csv(os.path.join(args.mav0_dir, "imu0", "data.csv"))]
+    # Same window as embed_euroc_data.py: up to 50 ms past the last frame.
+    last_cam_ts = max(cam0[-1][0], cam1[-1][0])
+    imu = [e for e in imu if e[0] <= last_cam_ts + 50000000]
+
+    gt = []
+    gt_csv = os.path.join(args.mav0_dir, "state_groundtruth_estimate0", "data.csv")
+    if os.path.exists(gt_csv):
+        # timestamp, p xyz, q wxyz (velocity / bias columns dropped)
+        gt = [(int(r[0]), *map(float, r[1:8])) for r in read_csv(gt_csv)]
+        gt = [e for e in gt if imu and imu[0][0] <= e[0] <= imu[-1][0]]
+
+    entries = []
+    width = height = 0
+
+    with open(args.output, "wb") as out:
+        out.write(b"\0" * struct.calcsize(HEADER_FMT))   # patched at the end
+
+        def write_chunk(stream, payload, records, first_ts, last_ts, compress):
+            codec, stored = CODEC_NONE, payload
+            if compress:
+                packed = lz4_compress_block(payload)
+                if len(packed) < len(payload):
+                    codec, stored = CODEC_LZ4, packed
+            pad = (-out.tell()) % CHUNK_ALIGN
+            out.write(b"\0" * pad)
+            offset = out.tell()
+            out.write(stored)
+            entries.append((stream, codec, records, len(payload), offset,
+                            len(stored), 0, first_ts, last_ts))
+
+        # Interleave in timestamp order so a streaming reader on a slow
+        # filesystem reads roughly sequentially.
+        imu_pos = 0
+        for n, ((ts0, fn0), (ts1, fn1)) in enumerate(zip(cam0, cam1)):
+            while imu_pos < len(imu) and imu[imu_pos][0] <= ts0:
+                batch = imu[imu_pos:imu_pos + args.imu_chunk]
+                payload = b"".join(struct.pack(IMU_FMT, *s) for s in batch)
+                write_chunk(STREAM_IMU, payload, len(batch), batch[0][0], batch[-1][0], args.lz4)
+                imu_pos += len(batch)
+
+            for stream, cam, ts, fn in ((STREAM_CAM0, "cam0", ts0, fn0), (STREAM_CAM1, "cam1", ts1, fn1)):
+                with open(os.path.join(args.mav0_dir, cam, "data", fn), "rb") as pf:
+                    png = pf.read()
+                if args.cam_encoding == "png":
+                    # PNG is already deflated; LZ4 on top would not pay off.
+                    write_chunk(stream, png, 1, ts, ts, False)
+                    if not width:
+                        width, height = struct.unpack(">II", png[16:24])
+                else:
+                    width, height, pixels = decode_png_gray8(png)
+                    write_chunk(stream, pixels, 1, ts, ts, args.lz4)
+
+            if (n + 1) % 100 == 0:
+                print(f"  packed {n + 1}/{frames} frames")
+
+        while imu_pos < len(imu):
+            batch = imu[imu_pos:imu_pos + args.imu_chunk]
+            payload = b"".join(struct.pack(IMU_FMT, *s) for s in batch)
+            write_chunk(STREAM_IMU, payload, len(batch), batch[0][0], batch[-1][0], args.lz4)
+            imu_pos += len(batch)
+
+        # Ground truth is read once at start-up, so it goes after the
+        # interleaved sensor data.
+        for pos in range(0, len(gt), args.imu_chunk):
+            batch = gt[pos:pos + args.imu_chunk]
+            payload = b"".join(struct.pack(GT_FMT, *s, 0) for s in batch)
+            write_chunk(STREAM_GT, payload, len(batch), batch[0][0], batch[-1][0], args.lz4)
+
+        pad = (-out.tell()) % 8
+        out.write(b"\0" * pad)
+        index_offset = out.tell()
+        for e in entries:
+            out.write(struct.pack(ENTRY_FMT, *e))
+
+        out.seek(0)
+        out.write(struct.pack(HEADER_FMT, MAGIC, VERSION, len(entries), index_offset,
+                              CAM_PNG if args.cam_encoding == "png" else CAM_RAW,
+                              width, height, struct.calcsize(IMU_FMT)))
+        total = index_offset + len(entries) * struct.calcsize(ENTRY_FMT)
+
+    imu_chunks = sum(1 for e in entries if e[0] == STREAM_IMU)
+    print(f"Wrote {args.output}: {frames} stereo frames ({width}x{height} {args.cam_encoding}"
+          f"{', lz4' if args.lz4 else ''}), {len(imu)} IMU samples in {imu_chunks} chunks, "
+          f"{len(gt)} ground-truth poses, {len(entries)} chunks, {total / 1024 / 1024:.1f} MB")
+
+
+if __name__ == "__main__":
+    main()
@@ -10,6 +10,10 @@
 #include "../../src/data_format_opencv.hpp"
 
 #include "../../src/stoplight.hpp"
+#include "../../src/latency_tracker.hpp"
+#include "../../src/mtime.hpp"
+#include "../../src/lock_audit.hpp"
+#include "generated_config.hpp"
 
 using namespace ILLIXR;
 using namespace OpenVINS;
@@ -22,8 +26,8 @@ K_THREAD_STACK_DEFINE(openvins_stack, 16777216);
 K_MSGQ_DEFINE(openvins_imu_queue, sizeof(ImuMsg*), 500, 4);
 K_MSGQ_DEFINE(openvins_cam_queue, sizeof(CamMsg*), 50, 4);
 
-static constexpr uint32_t kExpectedCamFrames   = 50;
-static constexpr size_t   kImuSamplesPerWindow = 10;
+static constexpr int      kCalibImageWidth     = 752;   // EuRoC resolution the intrinsics below refer to
+static constexpr int      kCalibImageHeight    = 480;
 
 // ==============================================================================
 // VIO CONFIGURATION (EuRoC calibration)
@@ -47,7 +51,7 @@ VIOConfig create_vio_config() {
                -0.0257744366974,  0.00375618835797, 0.999660727178,    0.00981073058949,
                 0, 0, 0, 1;
     config.R_ItoC0 = T_C0toI.block<3,3>(0,0).transpose();
-    config.p_C0inI = -config.R_ItoC0 * T_C0toI.block<3,1>(0,3);
+    config.p_C0inI = T_C0toI.block<3,1>(0,3);
 
     Eigen::Matrix4d T_C1toI;
     T_C1toI <<  0.0125552670891, -0.999755099723,  0.0182237714554, -0.0198435579556,
@@ -55,7 +59,7 @@ VIOConfig create_vio_config() {
                -0.0253898008918,  0.0179005838253,  0.999517347078,   0.00786212447038,
                 0, 0, 0, 1;
     config.R_ItoC1 = T_C1toI.block<3,3>(0,0).transpose();
-    config.p_C1inI = -config.R_ItoC1 * T_C1toI.block<3,1>(0,3);
+    config.p_C1inI = T_C1toI.block<3,1>(0,3);
 
     config.sigma_gyro       = 0.00016968;
     config.sigma_accel      = 0.002;
@@ -74,6 +78,21 @@ VIOConfig create_vio_config() {
     config.stereo_search_radius   = 60;
     config.match_threshold        = 0.8;
     config.fb_check_thresh        = 2.0;
+    config.subpixel               = true;
+    config.tracker                = VIO_TRACKER == VioTracker::lk      ? VIOConfig::Tracker::lk
+                                  : VIO_TRACKER == VioTracker::pyramid ? VIOConfig::Tracker::pyramid
+                                  : VIOConfig::Tracker::box;
+    config.pyramid_levels         = VIO_PYRAMID_LEVELS;
+    config.imu_predict_search     = VIO_IMU_PREDICT;
+    config.predicted_search_radius = 8;
+    config.detect_grid_cols       = 8;
+    config.detect_grid_rows       = 5;
+    config.fast_threshold         = 20;
+    config.min_feature_distance   = 10;
+    config.image_width            = kCalibImageWidth;
+    config.image_height           = kCalibImageHeight;
+    config.distortion_lut_step    = 8;
+    config.rectify_stereo         = VIO_RECTIFY_STEREO;
 
     return config;
 }
@@ -85,14 +104,19 @@ VIOConfig create_vio_config() {
 // into openvins_imu_queue / openvins_cam_queue.  This plugin pulls
 // from the queues in lock-step:
 //
-//   1. give stoplight_imu  → IMU thread sends 10 samples into queue
-//   2. blocking-read 10 ImuMsg* from queue
-//   3. give stoplight_cam  → cam thread sends 1 frame into queue
-//   4. blocking-read 1 CamMsg* from queue
-//   5. if IMU behind camera timestamp, repeat step 1-2
-//   6. process camera frame, publish pose
+//   1. give stoplight_cam  → cam thread sends 1 frame into queue
+//   2. blocking-read 1 CamMsg* from queue, note its timestamp t
+//   3. set imu_request_until_ns = t, give stoplight_imu once
+//      → IMU thread sends every sample up to the first one at/after t
+//   4. blocking-read ImuMsg* until the IMU covers t (nullptr = no more IMU)
+//   5. process camera frame, publish pose
+//
+// The number of IMU samples per frame falls out of the timestamps, so the
+// pipeline works at any IMU/camera rate ratio.
 // ==============================================================================
 class OpenVINS_Plugin : public threadloop {
+    static constexpr int kVectorHart = 0;
+
 public:
     explicit OpenVINS_Plugin(phonebook_new& pb)
         : threadloop{pb, "openvins",
@@ -104,7 +128,15 @@ public:
         , cam_count_{0}
         , update_count_{0}
         , latest_imu_t_{0.0}
+        , latest_imu_ns_{0}
+        , first_imu_ns_{-1}
+        , imu_exhausted_{false}
+        , cam_exhausted_{false}
+        , frame_dequeue_mtime_{0}
     {
+        // The RVV NCC kernels keep vector registers that Zephyr does not
+        // save, so the thread that runs them stays on one hart.
+        if (ncc_kernels().prepare_hart) pin_to_cpu(kVectorHart);
         printf("[OpenVINS] constructed (main thread).\n");
     }
 
@@ -115,13 +147,21 @@ public:
         printf("[OpenVINS] VIOConfig done.\n");
 
         vio_estimator_ = new MSCKFEstimator(vio_config_);
-        printf("[OpenVINS] MSCKFEstimator done. Entering loop.\n");
+        printf("[OpenVINS] MSCKFEstimator done (NCC kernels: %s, tracker: %s). Entering loop.\n",
+               ncc_kernels().name, tracker_name());
     }
 
     skip_option _p_should_skip() override {
-        if (cam_count_ >= kExpectedCamFrames) {
-            printf("[OpenVINS] all %u camera frames processed — stopping\n",
-                   kExpectedCamFrames);
+        bool capped = VIO_MAX_FRAMES > 0 && cam_count_ >= static_cast<uint32_t>(VIO_MAX_FRAMES);
+        if (cam_exhausted_ || capped) {
+            if (cam_exhausted_)
+                printf("[OpenVINS] camera stream ended after %u frames — stopping\n",
+                       cam_count_);
+            else
+                printf("[OpenVINS] all %d camera frames processed — stopping\n",
+                       VIO_MAX_FRAMES);
+            report_tracking();
+            k_sem_give(&pipeline_done);
             return skip_option::stop;
         }
         return skip_option::run;
@@ -132,77 +172,89 @@ public:
 
         uint32_t iter = cam_count_;
 
-        // ── Step 1: release IMU, drain one window ────────────────────────
-        printf("[OpenVINS] iter=%u  STEP1: giving stoplight_imu\n", iter);
-        k_sem_give(&stoplight_imu);
-        k_yield();
-
-        printf("[OpenVINS] iter=%u  STEP1: waiting for %zu IMU msgs\n",
-               iter, kImuSamplesPerWindow);
-
-        for (size_t i = 0; i < kImuSamplesPerWindow; i++) {
-            ImuMsg* imu_ptr = nullptr;
-            int rc = k_msgq_get(&openvins_imu_queue, &imu_ptr, K_FOREVER);
-            if (rc != 0 || !imu_ptr) {
-                printf("[OpenVINS] iter=%u  ERROR: IMU get failed i=%zu rc=%d\n",
-                       iter, i, rc);
-                return;
-            }
-            process_imu(*imu_ptr);
-            delete imu_ptr;
-        }
-
-        printf("[OpenVINS] iter=%u  STEP1: got %zu IMU, latest_imu_t=%.4f s\n",
-               iter, kImuSamplesPerWindow, latest_imu_t_);
-
-        // ── Step 2: release camera, read one frame ───────────────────────
-        printf("[OpenVINS] iter=%u  STEP2: giving stoplight_cam\n", iter);
-        k_sem_give(&stoplight_cam);
+        // ── Step 1: release camera, read one frame ───────────────────────
+        printf("[OpenVINS] iter=%u  STEP1: giving stoplight_cam\n", iter);
+        audit_sem_give(&stoplight_cam, "stoplight_cam");
         k_yield();
 
-        printf("[OpenVINS] iter=%u  STEP2: waiting for cam msg\n", iter);
+        printf("[OpenVINS] iter=%u  STEP1: waiting for cam msg\n", iter);
 
         CamMsg* cam_ptr = nullptr;
-        int rc = k_msgq_get(&openvins_cam_queue, &cam_ptr, K_FOREVER);
-        if (rc != 0 || !cam_ptr) {
-            printf("[OpenVINS] iter=%u  ERROR: cam get failed rc=%d ptr=%p\n",
-                   iter, rc, cam_ptr);
+        int rc = audit_msgq_get(&openvins_cam_queue, &cam_ptr, K_FOREVER, "openvins_cam_queue");
+        if (rc != 0) {
+            printf("[OpenVINS] iter=%u  ERROR: cam get failed rc=%d\n", iter, rc);
+            return;
+        }
+        if (!cam_ptr) {
+            // offline_cam's end marker (frames may have been dropped by its
+            // cam_drop_policy, so this can come before VIO_MAX_FRAMES).
+            cam_exhausted_ = true;
             return;
         }
 
-        double cam_t = static_cast<double>(
-            cam_ptr->time.time_since_epoch().count()) * 1e-9;
-        printf("[OpenVINS] iter=%u  STEP2: got cam frame t=%.4f s\n", iter, cam_t);
+        frame_dequeue_mtime_ = read_mtime();
+        get_latency_tracker().record(LatencyStage::cam_to_vio,
+                                     cam_ptr->prov.ingest_mtime, frame_dequeue_mtime_);
 
-        // ── Step 3: ensure IMU covers camera timestamp ───────────────────
-        while (cam_t > latest_imu_t_ + 1e-7) {
-            printf("[OpenVINS] iter=%u  STEP3: IMU behind (%.4f < %.4f) — more IMU\n",
-                   iter, latest_imu_t_, cam_t);
+        int64_t cam_ns = static_cast<int64_t>(cam_ptr->time.time_since_epoch().count());
+        double  cam_t  = static_cast<double>(cam_ns) * 1e-9;
+        printf("[OpenVINS] iter=%u  STEP1: got cam frame t=%.4f s\n", iter, cam_t);
 
-            k_sem_give(&stoplight_imu);
+        // ── Step 2: one handshake for all IMU up to the camera timestamp ─
+        if (!imu_exhausted_ && cam_ns > latest_imu_ns_) {
+            atomic_set(&imu_request_until_ns, static_cast<atomic_val_t>(cam_ns));
+            printf("[OpenVINS] iter=%u  STEP2: giving stoplight_imu (until t=%.4f s)\n",
+                   iter, cam_t);
+            audit_sem_give(&stoplight_imu, "stoplight_imu");
             k_yield();
 
-            for (size_t i = 0; i < kImuSamplesPerWindow; i++) {
+            uint32_t received = 0;
+            while (latest_imu_ns_ < cam_ns) {
                 ImuMsg* imu_ptr = nullptr;
-                int rc2 = k_msgq_get(&openvins_imu_queue, &imu_ptr, K_FOREVER);
-                if (rc2 != 0 || !imu_ptr) {
-                    printf("[OpenVINS] iter=%u  ERROR: extra IMU get failed\n", iter);
+                int rc2 = audit_msgq_get(&openvins_imu_queue, &imu_ptr, K_FOREVER,
+                                         "openvins_imu_queue");
+                if (rc2 != 0) {
+                    printf("[OpenVINS] iter=%u  ERROR: IMU get failed rc=%d\n", iter, rc2);
                     delete cam_ptr;
                     return;
                 }
+                if (!imu_ptr) {
+                    printf("[OpenVINS] iter=%u  STEP2: IMU stream ended at %.4f s\n",
+                           iter, latest_imu_t_);
+                    imu_exhausted_ = true;
+                    break;
+                }
                 process_imu(*imu_ptr);
                 delete imu_ptr;
+                received++;
             }
-            printf("[OpenVINS] iter=%u  STEP3: latest_imu_t now %.4f s\n",
-                   iter, latest_imu_t_);
+            printf("[OpenVINS] iter=%u  STEP2: got %u IMU, latest_imu_t=%.4f s\n",
+                   iter, received, latest_imu_t_);
         }
 
-        // ── Step 4: process the camera frame ─────────────────────────────
-        printf("[OpenVINS] iter=%u  STEP4: processing camera frame\n", iter);
+        // ── Step 3: process the camera frame ─────────────────────────────
+        printf("[OpenVINS] iter=%u  STEP3: processing camera frame\n", iter);
         process_camera_frame(*cam_ptr);
         delete cam_ptr;
 
-        printf("[OpenVINS] iter=%u  STEP4: done (cam_count=%u)\n", iter, cam_count_);
+        printf("[OpenVINS] iter=%u  STEP3: done (cam_count=%u)\n", iter, cam_count_);
+    }
+
+    void report_tracking() const {
+        const TrackStats& st = vio_estimator_->track_stats();
+        if (st.frames == 0) return;
+        printf("[OpenVINS] tracking  tracker=%s  avg=%.3f ms/frame over %zu frames  "
+               "kept=%zu/%zu tracks\n",
+               tracker_name(), static_cast<double>(st.ticks) * 1e3 / kMtimeHz / st.frames,
+               st.frames, st.tracked, st.attempted);
+    }
+
+    const char* tracker_name() const {
+        switch (vio_config_.tracker) {
+            case VIOConfig::Tracker::lk:      return "lk";
+            case VIOConfig::Tracker::pyramid: return "pyramid";
+            default:                          return "box";
+        }
     }
 
     void stop() override {
@@ -236,15 +288,31 @@ private:
     uint32_t cam_count_;
     uint32_t update_count_;
     double   latest_imu_t_;
+    int64_t  latest_imu_ns_;
+    int64_t  first_imu_ns_;          // for the measured IMU rate in ImuParams
+    bool     imu_exhausted_;         // producer sent its end marker
+    bool     cam_exhausted_;
+    bool     intrinsics_scaled_ = false;  // checked against the first frame's size
+    uint64_t frame_dequeue_mtime_;   // mtime when the current CamMsg left the queue
 
     void process_imu(const ImuMsg& msg) {
         imu_count_++;
-        double t = static_cast<double>(msg.time.time_since_epoch().count()) * 1e-9;
+        int64_t t_ns = static_cast<int64_t>(msg.time.time_since_epoch().count());
+        double  t    = static_cast<double>(t_ns) * 1e-9;
         printf("[OpenVINS] process_imu #%u  t=%.4f s\n", imu_count_, t);
-        latest_imu_t_ = t;
+        if (first_imu_ns_ < 0) first_imu_ns_ = t_ns;
+        latest_imu_ns_ = t_ns;
+        latest_imu_t_  = t;
         vio_estimator_->feed_imu(t, msg.angular_v, msg.linear_a);
     }
 
+    // Mean IMU rate seen so far; the EuRoC nominal 200 Hz until there is data.
+    double measured_imu_rate() const {
+        if (imu_count_ < 2 || latest_imu_ns_ <= first_imu_ns_) return 200.0;
+        return static_cast<double>(imu_count_ - 1) * 1e9 /
+               static_cast<double>(latest_imu_ns_ - first_imu_ns_);
+    }
+
     void process_camera_frame(const CamMsg& msg) {
         cam_count_++;
         double t = static_cast<double>(msg.time.time_since_epoch().count()) * 1e-9;
@@ -262,7 +330,18 @@ private:
             return;
         }
 
-        vio_estimator_->feed_stereo(t, msg.img0, msg.img1);
+        if (!intrinsics_scaled_) {
+            // Frames may be embedded pre-downscaled (embed_euroc_data.py --downscale).
+            if (msg.img0.cols != kCalibImageWidth) {
+                double scale = static_cast<double>(msg.img0.cols) / kCalibImageWidth;
+                printf("[OpenVINS] image width %d != calibration %d — scaling intrinsics by %.3f\n",
+                       msg.img0.cols, kCalibImageWidth, scale);
+                vio_estimator_->rescale_cameras(scale);
+            }
+            intrinsics_scaled_ = true;
+        }
+
+        vio_estimator_->feed_stereo(t, msg.img0, msg.img1, msg.pre_equalized);
 
         if (!vio_estimator_->is_initialized()) {
             printf("[OpenVINS] cam #%u: not yet initialized\n", cam_count_);
@@ -285,7 +364,7 @@ private:
             return;
         }
 
-        PoseMsg pose_msg{msg.time, pos_f, quat_f};
+        PoseMsg pose_msg{msg.time, pos_f, quat_f, msg.prov};
         node().publish_to<PoseMsg>("openvins_pose", pose_msg);
 
         ImuIntegratorInput integrator_msg{
@@ -298,16 +377,20 @@ private:
                 vio_config_.sigma_accel_bias,
                 vio_config_.gravity,
                 1.0,
-                200.0
+                measured_imu_rate()
             },
             state.b_accel,
             state.b_gyro,
             state.p_IinG,
             state.v_IinG,
-            state.q_GtoI
+            state.q_GtoI,
+            msg.prov
         };
         node().publish_to<ImuIntegratorInput>("imu_integrator", integrator_msg);
 
+        get_latency_tracker().record(LatencyStage::vio_update,
+                                     frame_dequeue_mtime_, read_mtime());
+
         update_count_++;
 
         printf(" [OpenVINS] UPDATE #%u  cam_t=%.4f s\n"
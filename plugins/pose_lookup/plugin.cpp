@@ -6,6 +6,7 @@
 #include "illixr/pose_prediction.hpp"
 #include "utils.hpp"
 
+#include <atomic>
 #include <memory>
 #include <shared_mutex>
 
@@ -17,8 +18,8 @@ public:
         : sb{pb->lookup_impl<switchboard>()}
         , _m_clock{pb->lookup_impl<RelativeClock>()}
         , _m_sensor_data{load_data()}
-        , _m_sensor_data_it{_m_sensor_data.cbegin()}
-        , dataset_first_time{_m_sensor_data_it->first}
+        , _m_lookup_hint{0}
+        , dataset_first_time{_m_sensor_data.front_time()}
         , _m_vsync_estimate{sb->get_reader<switchboard::event_wrapper<time_point>>("vsync_estimate")} /// TODO: Set with #198
         , enable_alignment{ILLIXR::str_to_bool(getenv_or("ILLIXR_ALIGNMENT_ENABLE", "False"))}
         , init_pos_offset{Eigen::Vector3f::Zero()}
@@ -31,9 +32,9 @@ public:
             load_align_parameters(path_to_alignment, align_rot, align_trans, align_quat, align_scale);
         }
         // Read position data of the first frame
-        init_pos_offset = _m_sensor_data.cbegin()->second.position;
+        init_pos_offset = pose_at_row(_m_sensor_data, 0).position;
 
-        auto newoffset = correct_pose(_m_sensor_data.begin()->second).orientation;
+        auto newoffset = correct_pose(pose_at_row(_m_sensor_data, 0)).orientation;
         set_offset(newoffset);
     }
 
@@ -125,30 +126,27 @@ public:
     fast_pose_type get_fast_pose(time_point time) const override {
         ullong lookup_time = time.time_since_epoch().count() + dataset_first_time;
 
-        auto nearest_row = _m_sensor_data.upper_bound(lookup_time);
-
-        if (nearest_row == _m_sensor_data.cend()) {
 #ifndef NDEBUG
+        if (lookup_time > _m_sensor_data.back_time()) {
             spdlog::get("illixr")->debug("[pose_lookup] Time {} ({} + {}) after last datum {}", lookup_time,
                                          std::chrono::nanoseconds(time.time_since_epoch()).count(), dataset_first_time,
-                                         _m_sensor_data.rbegin()->first);
-#endif
-            nearest_row--;
-        } else if (nearest_row == _m_sensor_data.cbegin()) {
-#ifndef NDEBUG
+                                         _m_sensor_data.back_time());
+        } else if (lookup_time < _m_sensor_data.front_time()) {
             spdlog::get("illixr")->debug("[pose_lookup] Time {} ({} + {}) before first datum {}", lookup_time,
                                          std::chrono::nanoseconds(time.time_since_epoch()).count(), dataset_first_time,
-                                         _m_sensor_data.cbegin()->first);
-#endif
-        } else {
-            // "std::map::upper_bound" returns an iterator to the first pair whose key is GREATER than the argument.
-            // I already know we aren't at the begin()
-            // So I will decrement nearest_row here.
-            nearest_row--;
+                                         _m_sensor_data.front_time());
         }
+#endif
+
+        // Last datum at or before lookup_time (the first one if none is). Lookups
+        // follow vsync, so the previous answer is almost always this row or the
+        // one before it; the hint is only a starting point, so a stale value
+        // from a concurrent caller is harmless.
+        size_t nearest_row = _m_sensor_data.floor_index(lookup_time, _m_lookup_hint.load(std::memory_order_relaxed));
+        _m_lookup_hint.store(nearest_row, std::memory_order_relaxed);
 
-        auto looked_up_pose        = nearest_row->second;
-        looked_up_pose.sensor_time = time_point{std::chrono::nanoseconds{nearest_row->first - dataset_first_time}};
+        auto looked_up_pose        = pose_at_row(_m_sensor_data, nearest_row);
+        looked_up_pose.sensor_time = time_point{std::chrono::nanoseconds{_m_sensor_data.time(nearest_row) - dataset_first_time}};
         return fast_pose_type{
             .pose = correct_pose(looked_up_pose), .predict_computed_time = _m_clock->now(), .predict_target_time = time};
     }
@@ -159,8 +157,8 @@ private:
     mutable Eigen::Quaternionf                 offset{Eigen::Quaternionf::Identity()};
     mutable std::shared_mutex                  offset_mutex;
 
-    const std::map<ullong, sensor_types>                        _m_sensor_data;
-    std::map<ullong, sensor_types>::const_iterator              _m_sensor_data_it;
+    const sensor_types                                          _m_sensor_data;
+    mutable std::atomic<size_t>                                 _m_lookup_hint;
     ullong                                                      dataset_first_time;
     switchboard::reader<switchboard::event_wrapper<time_point>> _m_vsync_estimate;
 
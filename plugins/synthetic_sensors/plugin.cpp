@@ -0,0 +1,245 @@
+#include <zephyr/kernel.h>
+#include <cstdint>
+#include <cstdio>
+#include <chrono>
+#include <Eigen/Dense>
+#include <Eigen/Geometry>
+
+#include <opencv2/core.hpp>
+
+#include "../../src/data_format.hpp"
+#include "../../src/data_format_opencv.hpp"
+#include "../../src/threadloop.hpp"
+#include "../../src/phonebook_new.hpp"
+#include "../../src/plugin_registry.hpp"
+#include "../../src/stoplight.hpp"
+#include "../../src/mtime.hpp"
+#include "../../src/lock_audit.hpp"
+#include "../../src/ground_truth.hpp"
+#include "../openvins/openvins_queues.hpp"
+#include "../imu_integrator/imu_integrator_queue.hpp"
+
+#include "generated_config.hpp"
+#include "synthetic_scene.hpp"
+
+using namespace ILLIXR;
+
+// ==============================================================================
+// SYNTHETIC SENSORS
+//
+// Drop-in replacement for offline_imu + offline_cam (and ground_truth) that
+// needs no dataset: list it instead of those in the profile. Everything is
+// generated from the analytic trajectory in synthetic_scene.hpp:
+//
+//   IMU     SYNTH_IMU_RATE_HZ (up to 1 kHz), noise- and bias-free
+//   stereo  SYNTH_WIDTH x SYNTH_HEIGHT at SYNTH_CAM_FPS, rendered from the
+//           textured room through the EuRoC calibration openvins uses
+//   length  SYNTH_DURATION_S of sensor time
+//   truth   GroundTruth::pose_at() from the same trajectory, exact at any t
+//
+// The stoplight protocol is the offline plugins' one: this thread answers
+// stoplight_cam, and an IMU thread answers stoplight_imu with every sample up
+// to the requested timestamp. Frames are rendered one ahead into two buffer
+// pairs: frame N+1 is drawn while openvins processes frame N, and openvins
+// has released a pair by the time the next stoplight_cam arrives.
+// ==============================================================================
+
+static constexpr int64_t kStartNs  = 1000000000000LL;   // 1000 s, as a dataset clock
+static constexpr size_t  kNumCams  = 2;
+
+K_THREAD_STACK_DEFINE(synthetic_sensors_stack, 65536);
+K_THREAD_STACK_DEFINE(synthetic_imu_stack, 16384);
+
+class SyntheticSensors : public threadloop, public GroundTruth {
+public:
+    explicit SyntheticSensors(phonebook_new& pb)
+        : threadloop{pb, "synthetic_sensors",
+                     synthetic_sensors_stack,
+                     K_THREAD_STACK_SIZEOF(synthetic_sensors_stack),
+                     5}
+        , cam0_{synthetic::euroc_camera(0, SYNTH_WIDTH), SYNTH_WIDTH, SYNTH_HEIGHT}
+        , cam1_{synthetic::euroc_camera(1, SYNTH_WIDTH), SYNTH_WIDTH, SYNTH_HEIGHT}
+        , imu_count_{static_cast<size_t>(SYNTH_DURATION_S * SYNTH_IMU_RATE_HZ) + 1}
+        , frame_count_{static_cast<size_t>(SYNTH_DURATION_S * SYNTH_CAM_FPS)}
+        , imu_idx_{0}
+        , imu_dropped_{0}
+        , frame_idx_{0}
+        , stream_ended_{false}
+        , render_ticks_{0}
+        , rendered_frames_{0}
+    {
+        pb.register_impl<GroundTruth>(this);
+        printf("[synthetic_sensors] constructed  imu=%d Hz (%zu samples)  cam=%.1f fps "
+               "%dx%d (%zu frames)  span=%.1f s\n",
+               SYNTH_IMU_RATE_HZ, imu_count_, SYNTH_CAM_FPS,
+               SYNTH_WIDTH, SYNTH_HEIGHT, frame_count_, SYNTH_DURATION_S);
+    }
+
+    void _p_thread_setup() override {
+        for (auto& pair : buffers_)
+            for (auto& img : pair) img.create(SYNTH_HEIGHT, SYNTH_WIDTH, CV_8UC1);
+        if (frame_count_ > 0) render(0);
+
+        k_tid_t tid = k_thread_create(&imu_thread_, synthetic_imu_stack,
+                                      K_THREAD_STACK_SIZEOF(synthetic_imu_stack),
+                                      imu_thread_entry, this, nullptr, nullptr,
+                                      K_PRIO_PREEMPT(5), 0, K_NO_WAIT);
+        if (tid) k_thread_name_set(tid, "synthetic_imu");
+    }
+
+    skip_option _p_should_skip() override {
+        return stream_ended_ ? skip_option::stop : skip_option::run;
+    }
+
+    void _p_one_iteration() override {
+        audit_sem_take(&stoplight_cam, K_FOREVER, "stoplight_cam");
+        if (frame_idx_ >= frame_count_) {
+            end_stream();
+            return;
+        }
+
+        int64_t  ts_ns = frame_ts_ns(frame_idx_);
+        cv::Mat* pair  = buffers_[frame_idx_ % 2];
+        CamMsg*  msg   = new CamMsg{
+            ILLIXR::time_point{std::chrono::nanoseconds{ts_ns}},
+            pair[0],
+            pair[1],
+            Provenance{ts_ns, read_mtime(), static_cast<uint32_t>(frame_idx_)},
+            false
+        };
+
+        int rc = audit_msgq_put(&openvins_cam_queue, &msg, K_NO_WAIT, "openvins_cam_queue");
+        if (rc != 0) {
+            delete msg;
+            printf("[synthetic_sensors] ERROR: cam queue put failed rc=%d\n", rc);
+        }
+        printf("[synthetic_sensors] SENT frame #%03zu  ts=%lld ns  img=%dx%d\n",
+               frame_idx_, (long long)ts_ns, SYNTH_WIDTH, SYNTH_HEIGHT);
+
+        // The other pair was released with the previous CamMsg.
+        ++frame_idx_;
+        if (frame_idx_ < frame_count_) render(frame_idx_);
+    }
+
+    // ── GroundTruth ──────────────────────────────────────────────────────────
+
+    bool pose_at(int64_t t_ns, PoseMsg& out) const override {
+        if (t_ns < first_ts_ns() || t_ns > last_ts_ns()) return false;
+        synthetic::BodyState s = trajectory_.at(seconds(t_ns));
+        out.timestamp   = time_point{std::chrono::nanoseconds{t_ns}};
+        out.position    = s.p.cast<float>();
+        out.orientation = s.q.cast<float>();
+        out.prov        = Provenance{t_ns, read_mtime(), 0};
+        return true;
+    }
+
+    bool    available()   const override { return true; }
+    int64_t first_ts_ns() const override { return kStartNs; }
+    int64_t last_ts_ns()  const override { return imu_ts_ns(imu_count_ - 1); }
+
+private:
+    synthetic::Trajectory trajectory_;
+    synthetic::Renderer   cam0_;
+    synthetic::Renderer   cam1_;
+    cv::Mat               buffers_[2][kNumCams];
+
+    size_t          imu_count_;
+    size_t          frame_count_;
+    size_t          imu_idx_;        // IMU thread only
+    size_t          imu_dropped_;    // integrator queue full
+    size_t          frame_idx_;
+    bool            stream_ended_;
+    uint64_t        render_ticks_;
+    size_t          rendered_frames_;
+    struct k_thread imu_thread_;
+
+    static double seconds(int64_t t_ns) {
+        return static_cast<double>(t_ns - kStartNs) * 1e-9;
+    }
+
+    static int64_t imu_ts_ns(size_t i) {
+        return kStartNs + static_cast<int64_t>(i) * 1000000000LL / SYNTH_IMU_RATE_HZ;
+    }
+
+    static int64_t frame_ts_ns(size_t i) {
+        // Frames start one IMU period in, so the first request covers a sample.
+        return kStartNs + 1000000000LL / SYNTH_IMU_RATE_HZ +
+               static_cast<int64_t>(static_cast<double>(i) * 1e9 / SYNTH_CAM_FPS);
+    }
+
+    void render(size_t idx) {
+        uint64_t             t0   = read_mtime();
+        synthetic::BodyState s    = trajectory_.at(seconds(frame_ts_ns(idx)));
+        cv::Mat*             pair = buffers_[idx % 2];
+        cam0_.render(s, pair[0].data, pair[0].step);
+        cam1_.render(s, pair[1].data, pair[1].step);
+        render_ticks_ += read_mtime() - t0;
+        ++rendered_frames_;
+    }
+
+    void end_stream() {
+        CamMsg* end_marker = nullptr;
+        audit_msgq_put(&openvins_cam_queue, &end_marker, K_FOREVER, "openvins_cam_queue");
+        stream_ended_ = true;
+        double render_ms = rendered_frames_
+            ? static_cast<double>(render_ticks_) * 1e3 / kMtimeHz / rendered_frames_
+            : 0.0;
+        printf("[synthetic_sensors] end of stream  frames=%zu  render avg=%.2f ms/stereo pair\n",
+               frame_count_, render_ms);
+    }
+
+    // ── IMU thread ───────────────────────────────────────────────────────────
+
+    static void imu_thread_entry(void* p1, void*, void*) {
+        auto* self = static_cast<SyntheticSensors*>(p1);
+        while (true) self->answer_imu_request();
+    }
+
+    // Same contract as offline_imu: every sample up to the first one at or
+    // after the requested time, or an end marker once the sequence is over.
+    void answer_imu_request() {
+        audit_sem_take(&stoplight_imu, K_FOREVER, "stoplight_imu");
+        int64_t until_ns = static_cast<int64_t>(atomic_get(&imu_request_until_ns));
+
+        bool covered = false;
+        while (!covered && imu_idx_ < imu_count_) {
+            int64_t ts_ns = imu_ts_ns(imu_idx_);
+            covered = ts_ns >= until_ns;
+            send_imu(ts_ns);
+            ++imu_idx_;
+        }
+
+        if (!covered) {
+            ImuMsg* end_marker = nullptr;
+            audit_msgq_put(&openvins_imu_queue, &end_marker, K_FOREVER, "openvins_imu_queue");
+            printf("[synthetic_sensors] end of IMU data at #%zu — sent end marker "
+                   "(integrator drops=%zu)\n", imu_idx_, imu_dropped_);
+        }
+    }
+
+    void send_imu(int64_t ts_ns) {
+        synthetic::BodyState s = trajectory_.at(seconds(ts_ns));
+
+        ImuMsg* msg_vins = new ImuMsg{
+            time_point{std::chrono::nanoseconds{ts_ns}},
+            s.gyro,
+            s.accel,
+            Provenance{ts_ns, read_mtime(), static_cast<uint32_t>(imu_idx_)}
+        };
+        ImuMsg* msg_int = new ImuMsg{*msg_vins};
+
+        int rc1 = audit_msgq_put(&openvins_imu_queue,   &msg_vins, K_FOREVER, "openvins_imu_queue");
+        int rc2 = audit_msgq_put(&imu_integrator_queue, &msg_int,  K_NO_WAIT, "imu_integrator_queue");
+
+        if (rc1 != 0) { delete msg_vins; printf("[synthetic_sensors] ERROR: openvins queue put failed rc=%d\n", rc1); }
+        // At high IMU rates the integrator may lag; count instead of logging each drop.
+        if (rc2 != 0) { delete msg_int; ++imu_dropped_; }
+    }
+};
+
+void start_synthetic_sensors(phonebook_new& pb) {
+    static SyntheticSensors instance{pb};
+    instance.start();
+}
+
+REGISTER_PLUGIN(synthetic_sensors);
@@ -0,0 +1,276 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <Eigen/Dense>
+#include <Eigen/Geometry>
+
+// ==============================================================================
+// SYNTHETIC SCENE — analytic trajectory, exact IMU, textured room renderer
+//
+// Trajectory
+//   The body moves on a Lissajous curve around the middle of the room and
+//   sways about its nominal orientation (IMU x up, cameras looking along
+//   world +X, the EuRoC rig mounting). Position and the three sway angles are
+//   sums of sinusoids, so velocity, acceleration and angular rate are
+//   differentiated in closed form: the IMU samples are exact, and so is the
+//   ground truth at any timestamp.
+//
+// Scene
+//   The inside of an axis-aligned box. Every wall carries the same
+//   procedural texture: cells with hashed intensities (strong corners for
+//   FAST and the NCC templates) plus a smooth value-noise octave (gradients
+//   for the KLT refinement).
+//
+// Cameras
+//   The EuRoC cam0/cam1 intrinsics, radtan distortion and extrinsics that
+//   openvins' create_vio_config() uses, scaled by width / 752 the same way
+//   openvins rescales them, so the estimator sees geometrically consistent
+//   stereo at any resolution. Pixel rays come from a coarse undistortion
+//   grid (one exact ray every kRayGrid pixels, bilinear in between).
+// ==============================================================================
+
+namespace ILLIXR {
+namespace synthetic {
+
+static constexpr double kGravity = 9.81;
+
+// Room: x, y in [-kRoomHalf, kRoomHalf], z in [0, kRoomHeight] (m).
+static constexpr double kRoomHalf   = 4.0;
+static constexpr double kRoomHeight = 3.0;
+
+struct BodyState {
+    Eigen::Vector3d    p;      // position in world
+    Eigen::Vector3d    v;
+    Eigen::Quaterniond q;      // body → world
+    Eigen::Vector3d    gyro;   // body frame, rad/s
+    Eigen::Vector3d    accel;  // specific force, body frame, m/s²
+};
+
+class Trajectory {
+public:
+    // Body state at t seconds after the start.
+    BodyState at(double t) const {
+        BodyState s;
+        for (int i = 0; i < 3; i++) {
+            double ph = kPosW[i] * t + kPosPhase[i];
+            s.p(i)    = kCenter[i] + kPosAmp[i] * std::sin(ph);
+            s.v(i)    = kPosAmp[i] * kPosW[i] * std::cos(ph);
+        }
+        Eigen::Vector3d a;
+        for (int i = 0; i < 3; i++) {
+            double ph = kPosW[i] * t + kPosPhase[i];
+            a(i)      = -kPosAmp[i] * kPosW[i] * kPosW[i] * std::sin(ph);
+        }
+
+        // Sway E = Rz(yaw) Ry(pitch) Rx(roll), applied on top of the mount.
+        double ang[3], rate[3];
+        for (int i = 0; i < 3; i++) {
+            double ph = kRotW[i] * t + kRotPhase[i];
+            ang[i]    = kRotAmp[i] * std::sin(ph);
+            rate[i]   = kRotAmp[i] * kRotW[i] * std::cos(ph);
+        }
+        Eigen::Matrix3d Rz = Eigen::AngleAxisd(ang[0], Eigen::Vector3d::UnitZ()).toRotationMatrix();
+        Eigen::Matrix3d Ry = Eigen::AngleAxisd(ang[1], Eigen::Vector3d::UnitY()).toRotationMatrix();
+        Eigen::Matrix3d Rx = Eigen::AngleAxisd(ang[2], Eigen::Vector3d::UnitX()).toRotationMatrix();
+        Eigen::Matrix3d R  = Rz * Ry * Rx * mount();
+
+        Eigen::Vector3d w_world = rate[0] * Eigen::Vector3d::UnitZ() +
+                                  rate[1] * (Rz * Eigen::Vector3d::UnitY()) +
+                                  rate[2] * (Rz * Ry * Eigen::Vector3d::UnitX());
+
+        s.q     = Eigen::Quaterniond{R};
+        s.gyro  = R.transpose() * w_world;
+        s.accel = R.transpose() * (a + Eigen::Vector3d{0.0, 0.0, kGravity});
+        return s;
+    }
+
+private:
+    // Body x up, body z (camera optical axis) along world +X, body y = -Y.
+    static Eigen::Matrix3d mount() {
+        Eigen::Matrix3d R;
+        R << 0,  0, 1,
+             0, -1, 0,
+             1,  0, 0;
+        return R;
+    }
+
+    // Periods of a few seconds: enough excitation for openvins to initialize
+    // without leaving the room.                      x      y      z
+    static constexpr double kCenter[3]    = {  0.0,   0.0,   1.5 };
+    static constexpr double kPosAmp[3]    = {  0.6,   0.8,   0.3 };
+    static constexpr double kPosW[3]      = {  0.9,   1.3,   1.7 };
+    static constexpr double kPosPhase[3]  = {  0.0,   0.5,   1.0 };
+    //                                        yaw    pitch  roll
+    static constexpr double kRotAmp[3]    = {  0.35,  0.15,  0.10 };
+    static constexpr double kRotW[3]      = {  0.7,   1.1,   1.9 };
+    static constexpr double kRotPhase[3]  = {  0.3,   0.0,   2.0 };
+};
+
+// ── Cameras ──────────────────────────────────────────────────────────────────
+
+struct Camera {
+    double          fx, fy, cx, cy;
+    double          k1, k2, p1, p2;
+    Eigen::Matrix3d R_CtoI;
+    Eigen::Vector3d p_CinI;
+};
+
+static constexpr int kCalibImageWidth = 752;
+
+// EuRoC calibration, kept equal to create_vio_config() in openvins/plugin.cpp.
+inline Camera euroc_camera(size_t cam, int width) {
+    double s = static_cast<double>(width) / kCalibImageWidth;
+    Camera c;
+    Eigen::Matrix4d T;
+    if (cam == 0) {
+        c = Camera{458.654 * s, 457.296 * s, 367.215 * s, 248.375 * s,
+                   -0.28340811, 0.07395907, 0.00019359, 1.76187114e-05, {}, {}};
+        T <<  0.0148655429818, -0.999880929698,  0.00414029679422, -0.0216401454975,
+              0.999557249008,   0.0149672133247,  0.025715529948,   -0.064676986768,
+             -0.0257744366974,  0.00375618835797, 0.999660727178,    0.00981073058949,
+              0, 0, 0, 1;
+    } else {
+        c = Camera{457.587 * s, 456.134 * s, 379.999 * s, 255.238 * s,
+                   -0.28368365, 0.07451284, -0.00010473, -3.55590700e-05, {}, {}};
+        T <<  0.0125552670891, -0.999755099723,  0.0182237714554, -0.0198435579556,
+              0.999598781151,   0.0130119051815,  0.0251588363115,  0.0453689425024,
+             -0.0253898008918,  0.0179005838253,  0.999517347078,   0.00786212447038,
+              0, 0, 0, 1;
+    }
+    Eigen::Matrix3d R = T.block<3, 3>(0, 0);
+    // Re-orthonormalize the printed-precision rotation.
+    c.R_CtoI = Eigen::Quaterniond{R}.normalized().toRotationMatrix();
+    c.p_CinI = T.block<3, 1>(0, 3);
+    return c;
+}
+
+// ── Texture ──────────────────────────────────────────────────────────────────
+
+inline uint32_t hash2(int32_t x, int32_t y, uint32_t seed) {
+    uint32_t h = static_cast<uint32_t>(x) * 0x8da6b343u ^
+                 static_cast<uint32_t>(y) * 0xd8163841u ^ seed * 0xcb1ab31fu;
+    h ^= h >> 13;
+    h *= 0x5bd1e995u;
+    h ^= h >> 15;
+    return h;
+}
+
+// Wall intensity at surface coordinates (u, v) in metres, 0..255.
+inline int texture(double u, double v, uint32_t seed) {
+    static constexpr double kCell  = 0.25;   // m, hashed-intensity cells
+    static constexpr double kNoise = 0.06;   // m, value-noise lattice
+
+    double   cu = std::floor(u / kCell), cv = std::floor(v / kCell);
+    int      base = 40 + static_cast<int>(hash2(static_cast<int32_t>(cu),
+                                                static_cast<int32_t>(cv), seed) % 176);
+
+    double   nu = u / kNoise, nv = v / kNoise;
+    double   fu = std::floor(nu), fv = std::floor(nv);
+    double   au = nu - fu, av = nv - fv;
+    au = au * au * (3.0 - 2.0 * au);
+    av = av * av * (3.0 - 2.0 * av);
+    int32_t  iu = static_cast<int32_t>(fu), iv = static_cast<int32_t>(fv);
+    uint32_t s2 = seed + 1;
+    double   n00 = hash2(iu,     iv,     s2) & 0xff, n10 = hash2(iu + 1, iv,     s2) & 0xff;
+    double   n01 = hash2(iu,     iv + 1, s2) & 0xff, n11 = hash2(iu + 1, iv + 1, s2) & 0xff;
+    double   n = (n00 + au * (n10 - n00)) + av * ((n01 + au * (n11 - n01)) -
+                                                 (n00 + au * (n10 - n00)));
+
+    int value = base + static_cast<int>((n - 127.5) * 0.25);
+    return value < 0 ? 0 : value > 255 ? 255 : value;
+}
+
+// ── Renderer ─────────────────────────────────────────────────────────────────
+
+class Renderer {
+public:
+    static constexpr int kRayGrid = 8;   // pixels between exact rays
+
+    Renderer(const Camera& cam, int width, int height)
+        : cam_{cam}, width_{width}, height_{height}
+        , gw_{(width + kRayGrid - 1) / kRayGrid + 1}
+        , gh_{(height + kRayGrid - 1) / kRayGrid + 1}
+    {
+        grid_.resize(static_cast<size_t>(gw_) * gh_);
+        for (int gy = 0; gy < gh_; gy++)
+            for (int gx = 0; gx < gw_; gx++)
+                grid_[gy * gw_ + gx] = undistort(gx * kRayGrid, gy * kRayGrid);
+    }
+
+    // Renders the view of a camera mounted on a body at `body` into `out`
+    // (height rows of width bytes, `stride` apart).
+    void render(const BodyState& body, uint8_t* out, size_t stride) const {
+        Eigen::Matrix3d R_BtoG = body.q.toRotationMatrix();
+        Eigen::Matrix3d R      = R_BtoG * cam_.R_CtoI;
+        Eigen::Vector3d o      = body.p + R_BtoG * cam_.p_CinI;
+
+        for (int y = 0; y < height_; y++) {
+            int    gy = y / kRayGrid;
+            double fy = static_cast<double>(y - gy * kRayGrid) / kRayGrid;
+            const Eigen::Vector2d* r0 = &grid_[gy * gw_];
+            const Eigen::Vector2d* r1 = &grid_[(gy + 1) * gw_];
+            uint8_t* row = out + static_cast<size_t>(y) * stride;
+
+            for (int x = 0; x < width_; x++) {
+                int    gx = x / kRayGrid;
+                double fx = static_cast<double>(x - gx * kRayGrid) / kRayGrid;
+                Eigen::Vector2d top = r0[gx] + fx * (r0[gx + 1] - r0[gx]);
+                Eigen::Vector2d bot = r1[gx] + fx * (r1[gx + 1] - r1[gx]);
+                Eigen::Vector2d n   = top + fy * (bot - top);
+
+                Eigen::Vector3d d = R * Eigen::Vector3d{n(0), n(1), 1.0};
+                row[x] = static_cast<uint8_t>(shade(o, d));
+            }
+        }
+    }
+
+private:
+    Camera                       cam_;
+    int                          width_, height_;
+    int                          gw_, gh_;
+    std::vector<Eigen::Vector2d> grid_;   // normalized image coordinates
+
+    // Inverse radtan by fixed-point iteration (converges for EuRoC's k1).
+    Eigen::Vector2d undistort(double u, double v) const {
+        double xd = (u - cam_.cx) / cam_.fx;
+        double yd = (v - cam_.cy) / cam_.fy;
+        double x = xd, y = yd;
+        for (int it = 0; it < 20; it++) {
+            double r2 = x * x + y * y;
+            double k  = 1.0 + cam_.k1 * r2 + cam_.k2 * r2 * r2;
+            double dx = 2.0 * cam_.p1 * x * y + cam_.p2 * (r2 + 2.0 * x * x);
+            double dy = cam_.p1 * (r2 + 2.0 * y * y) + 2.0 * cam_.p2 * x * y;
+            x = (xd - dx) / k;
+            y = (yd - dy) / k;
+        }
+        return {x, y};
+    }
+
+    // Intensity where the ray o + s d (s > 0) leaves the room.
+    static int shade(const Eigen::Vector3d& o, const Eigen::Vector3d& d) {
+        static constexpr double lo[3] = {-kRoomHalf, -kRoomHalf, 0.0};
+        static constexpr double hi[3] = { kRoomHalf,  kRoomHalf, kRoomHeight};
+
+        int    axis = 0;
+        double best = 1e30;
+        for (int i = 0; i < 3; i++) {
+            if (d(i) == 0.0) continue;
+            double s = ((d(i) > 0.0 ? hi[i] : lo[i]) - o(i)) / d(i);
+            if (s < best) {
+                best = s;
+                axis = i;
+            }
+        }
+        Eigen::Vector3d hit = o + best * d;
+        // Each wall gets its own seed so opposite walls differ.
+        uint32_t seed = static_cast<uint32_t>(axis * 2 + (d(axis) > 0.0 ? 1 : 0));
+        int      a    = (axis + 1) % 3, b = (axis + 2) % 3;
+        return texture(hit(a), hit(b), seed);
+    }
+};
+
+} // namespace synthetic
+} // namespace ILLIXR
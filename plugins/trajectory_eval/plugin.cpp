@@ -0,0 +1,174 @@
+#include <zephyr/kernel.h>
+#include <cstdint>
+#include <cstdio>
+#include <Eigen/Dense>
+#include <Eigen/Geometry>
+
+#include "../../src/threadloop.hpp"
+#include "../../src/phonebook_new.hpp"
+#include "../../src/plugin_registry.hpp"
+#include "../../src/data_format.hpp"
+#include "../../src/ground_truth.hpp"
+#include "generated_config.hpp"
+
+#include "trajectory_metrics.hpp"
+
+using namespace ILLIXR;
+
+// ==============================================================================
+// TRAJECTORY EVALUATION
+//
+// Scores the estimator against ground truth while the pipeline runs:
+//   openvins        poses on "openvins_pose" (one per camera update)
+//   imu_integrator  poses on "renderer"      (one per IMU sample)
+// Each pose is matched with GroundTruth::pose_at() at its own timestamp and
+// fed to an ATE accumulator (Umeyama-aligned RMSE) and an RPE accumulator
+// (EVAL_RPE_WINDOW_S window). Memory is constant in the run length.
+//
+// Each stream's callback runs on its publisher's thread and touches only that
+// stream's accumulators and GroundTruth pointer, so no lock is needed. The
+// pointer is looked up from the callbacks, retrying until the provider has
+// registered: the runtime constructs and starts plugins one at a time, so a
+// provider started after trajectory_eval is not there yet in _p_thread_setup(). A line is printed every
+// EVAL_REPORT_EVERY openvins updates, and a summary at shutdown.
+//
+// Both publishers send p_IinG and q_GtoI; the ground truth is body-in-world,
+// so the estimate's orientation is conjugated before comparing.
+// ==============================================================================
+
+K_THREAD_STACK_DEFINE(trajectory_eval_stack, 8192);
+
+class TrajectoryEval : public threadloop {
+public:
+    explicit TrajectoryEval(phonebook_new& pb)
+        : threadloop{pb, "trajectory_eval",
+                     trajectory_eval_stack,
+                     K_THREAD_STACK_SIZEOF(trajectory_eval_stack),
+                     5}
+        , pb_{pb}
+        , vio_{"openvins", EVAL_RPE_WINDOW_S}
+        , integrator_{"imu_integrator", EVAL_RPE_WINDOW_S}
+    {
+        node().set_shutdown_callback(&TrajectoryEval::on_shutdown_cb, this);
+        printf("[trajectory_eval] constructed  rpe_window=%.2f s  align=%s\n",
+               EVAL_RPE_WINDOW_S, EVAL_ALIGN_SCALE ? "sim3" : "se3");
+    }
+
+    void _p_thread_setup() override {
+        node().subscribe_to<PoseMsg>("openvins", "openvins_pose",
+                                     &TrajectoryEval::on_vio_pose_cb, this);
+        node().subscribe_to<PoseMsg>("imu_integrator", "renderer",
+                                     &TrajectoryEval::on_integrator_pose_cb, this);
+    }
+
+    // Everything happens in the subscription callbacks.
+    skip_option _p_should_skip() override {
+        return skip_option::stop;
+    }
+
+    void _p_one_iteration() override { }
+
+private:
+    struct Stream {
+        const char*    name;
+        AteAccumulator ate;
+        RpeAccumulator rpe;
+        size_t             missed;
+        const GroundTruth* gt;
+        bool               no_truth;  // provider present but without data
+
+        Stream(const char* n, double window_s)
+            : name{n}, rpe{window_s}, missed{0}, gt{nullptr}, no_truth{false} { }
+    };
+
+    phonebook_new&     pb_;
+    Stream             vio_;
+    Stream             integrator_;
+
+    static void on_vio_pose_cb(void* ctx, const PoseMsg& msg) {
+        auto* self = static_cast<TrajectoryEval*>(ctx);
+        if (self->add(self->vio_, msg) && EVAL_REPORT_EVERY > 0 &&
+            self->vio_.ate.size() % EVAL_REPORT_EVERY == 0)
+            self->print_line(self->vio_);
+    }
+
+    static void on_integrator_pose_cb(void* ctx, const PoseMsg& msg) {
+        auto* self = static_cast<TrajectoryEval*>(ctx);
+        self->add(self->integrator_, msg);
+    }
+
+    static void on_shutdown_cb(void* ctx) {
+        static_cast<TrajectoryEval*>(ctx)->report();
+    }
+
+    bool add(Stream& s, const PoseMsg& msg) {
+        if (!s.gt && !s.no_truth) {
+            s.gt = pb_.lookup_impl<GroundTruth>();
+            if (s.gt && !s.gt->available()) {
+                s.gt       = nullptr;
+                s.no_truth = true;
+            }
+        }
+        if (!s.gt) {
+            ++s.missed;
+            return false;
+        }
+
+        int64_t t_ns = msg.timestamp.time_since_epoch().count();
+        PoseMsg truth;
+        if (!s.gt->pose_at(t_ns, truth)) {
+            ++s.missed;
+            return false;
+        }
+
+        EvalPose est{msg.position.cast<double>(),
+                     msg.orientation.cast<double>().conjugate().normalized()};
+        EvalPose gt {truth.position.cast<double>(),
+                     truth.orientation.cast<double>().normalized()};
+
+        s.ate.add(est.p, gt.p);
+        s.rpe.add(t_ns, est, gt);
+        return true;
+    }
+
+    void print_line(const Stream& s) const {
+        AteAccumulator::Result ate;
+        if (!s.ate.solve(EVAL_ALIGN_SCALE, ate)) return;
+        RpeAccumulator::Result rpe = s.rpe.result();
+        printf("[trajectory_eval] %s n=%zu  ATE=%.4f m  RPE(%.1fs) trans=%.4f m rot=%.3f deg\n",
+               s.name, ate.n, ate.rmse, s.rpe.window_s(), rpe.trans_rmse, rpe.rot_rmse);
+    }
+
+    void report() const {
+        printf("\n[trajectory_eval] ===== trajectory error vs ground truth =====\n");
+        for (const Stream* s : {&vio_, &integrator_}) {
+            AteAccumulator::Result ate;
+            if (!s->gt) {
+                printf("[trajectory_eval] %-14s no ground truth (add the ground_truth plugin and "
+                       "build with a dataset pack) — evaluation disabled\n", s->name);
+                continue;
+            }
+            if (!s->ate.solve(EVAL_ALIGN_SCALE, ate)) {
+                printf("[trajectory_eval] %-14s not enough matched poses (%zu, %zu without ground truth)\n",
+                       s->name, s->ate.size(), s->missed);
+                continue;
+            }
+            RpeAccumulator::Result rpe = s->rpe.result();
+            printf("[trajectory_eval] %-14s poses=%zu (missed %zu)\n", s->name, ate.n, s->missed);
+            printf("[trajectory_eval]   ATE  rmse=%.4f m  (%s, scale=%.4f)\n",
+                   ate.rmse, EVAL_ALIGN_SCALE ? "sim3" : "se3", ate.scale);
+            printf("[trajectory_eval]   RPE  window=%.1f s  pairs=%zu  trans rmse=%.4f max=%.4f m  "
+                   "rot rmse=%.3f max=%.3f deg\n",
+                   s->rpe.window_s(), rpe.n, rpe.trans_rmse, rpe.trans_max,
+                   rpe.rot_rmse, rpe.rot_max);
+        }
+        printf("[trajectory_eval] ==========================================\n\n");
+    }
+};
+
+void start_trajectory_eval(phonebook_new& pb) {
+    static TrajectoryEval instance{pb};
+    instance.start();
+}
+
+REGISTER_PLUGIN(trajectory_eval);
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <Eigen/Dense>
+#include <Eigen/Geometry>
+
+// ==============================================================================
+// TRAJECTORY METRICS — incremental ATE / RPE in constant memory
+//
+// AteAccumulator
+//   Keeps only the first-order and second-order sums of matched
+//   (estimate, ground truth) positions. The Umeyama alignment (SE(3), or
+//   Sim(3) with scale) and the RMSE after alignment both come from those
+//   sums in closed form:
+//
+//     Σ = cov(gt, est) = U D Vᵀ,  S = diag(1, 1, ±1)
+//     R = U S Vᵀ,  s = tr(DS) / var(est)  (1 without scale)
+//     SSE / n = var(gt) + s² var(est) − 2 s tr(DS)
+//
+//   Sums are taken relative to the first pair to limit cancellation.
+//
+// RpeAccumulator
+//   Relative pose error over a fixed time window Δ: for each new pair, the
+//   motion since the pose Δ earlier is compared between estimate and ground
+//   truth. A small ring of past pairs, spaced at least Δ/(kHistory/2) apart,
+//   bounds memory at any input rate.
+//
+// Poses are body-in-world: position of the body and body-to-world rotation.
+// ==============================================================================
+
+namespace ILLIXR {
+
+struct EvalPose {
+    Eigen::Vector3d    p;
+    Eigen::Quaterniond q;  // body → world
+};
+
+class AteAccumulator {
+public:
+    struct Result {
+        size_t             n;
+        double             rmse;  // m
+        double             scale;
+        Eigen::Matrix3d    R;     // est world → gt world
+        Eigen::Vector3d    t;
+    };
+
+    void add(const Eigen::Vector3d& est, const Eigen::Vector3d& gt) {
+        if (n_ == 0) {
+            x0_ = est;
+            y0_ = gt;
+        }
+        Eigen::Vector3d x = est - x0_;
+        Eigen::Vector3d y = gt  - y0_;
+        ++n_;
+        sx_  += x;
+        sy_  += y;
+        sxx_ += x.squaredNorm();
+        syy_ += y.squaredNorm();
+        syx_ += y * x.transpose();
+    }
+
+    size_t size() const { return n_; }
+
+    // Needs three pairs; false before that.
+    bool solve(bool with_scale, Result& out) const {
+        if (n_ < 3) return false;
+
+        double          inv_n = 1.0 / static_cast<double>(n_);
+        Eigen::Vector3d mu_x  = sx_ * inv_n;
+        Eigen::Vector3d mu_y  = sy_ * inv_n;
+        Eigen::Matrix3d cov   = syx_ * inv_n - mu_y * mu_x.transpose();
+        double          var_x = sxx_ * inv_n - mu_x.squaredNorm();
+        double          var_y = syy_ * inv_n - mu_y.squaredNorm();
+
+        Eigen::JacobiSVD<Eigen::Matrix3d> svd(cov, Eigen::ComputeFullU | Eigen::ComputeFullV);
+        Eigen::Matrix3d U = svd.matrixU();
+        Eigen::Matrix3d V = svd.matrixV();
+        Eigen::Vector3d S = Eigen::Vector3d::Ones();
+        if (U.determinant() * V.determinant() < 0.0) S(2) = -1.0;
+
+        double tr_ds = svd.singularValues().dot(S);
+        double s     = (with_scale && var_x > 1e-12) ? tr_ds / var_x : 1.0;
+        double mse   = var_y + s * s * var_x - 2.0 * s * tr_ds;
+
+        out.n     = n_;
+        out.rmse  = std::sqrt(mse > 0.0 ? mse : 0.0);
+        out.scale = s;
+        out.R     = U * S.asDiagonal() * V.transpose();
+        // Undo the first-pair offsets: gt = s R est + t.
+        out.t     = (mu_y + y0_) - s * out.R * (mu_x + x0_);
+        return true;
+    }
+
+private:
+    size_t          n_   = 0;
+    Eigen::Vector3d x0_  = Eigen::Vector3d::Zero();
+    Eigen::Vector3d y0_  = Eigen::Vector3d::Zero();
+    Eigen::Vector3d sx_  = Eigen::Vector3d::Zero();
+    Eigen::Vector3d sy_  = Eigen::Vector3d::Zero();
+    double          sxx_ = 0.0;
+    double          syy_ = 0.0;
+    Eigen::Matrix3d syx_ = Eigen::Matrix3d::Zero();
+};
+
+class RpeAccumulator {
+public:
+    static constexpr size_t kHistory = 64;
+
+    struct Result {
+        size_t n;
+        double trans_rmse;  // m
+        double trans_max;
+        double rot_rmse;    // deg
+        double rot_max;
+    };
+
+    explicit RpeAccumulator(double window_s = 1.0)
+        : window_ns_{static_cast<int64_t>(window_s * 1e9)}
+        , min_spacing_ns_{window_ns_ / static_cast<int64_t>(kHistory / 2)} { }
+
+    double window_s() const { return static_cast<double>(window_ns_) * 1e-9; }
+
+    void add(int64_t t_ns, const EvalPose& est, const EvalPose& gt) {
+        if (count_ > 0 && t_ns - newest().t_ns < min_spacing_ns_) return;
+
+        // Keep the latest entry at or before t - Δ as the oldest one.
+        while (count_ >= 2 && at(1).t_ns <= t_ns - window_ns_) pop();
+
+        if (count_ > 0 && oldest().t_ns <= t_ns - window_ns_) {
+            const Entry& a = oldest();
+            accumulate(relative(a.est, est), relative(a.gt, gt));
+        }
+
+        if (count_ == kHistory) pop();
+        ring_[(head_ + count_) % kHistory] = Entry{t_ns, est, gt};
+        ++count_;
+    }
+
+    Result result() const {
+        Result r{n_, 0.0, trans_max_, 0.0, rot_max_};
+        if (n_ > 0) {
+            r.trans_rmse = std::sqrt(trans_sq_ / static_cast<double>(n_));
+            r.rot_rmse   = std::sqrt(rot_sq_   / static_cast<double>(n_));
+        }
+        return r;
+    }
+
+private:
+    struct Entry {
+        int64_t  t_ns;
+        EvalPose est;
+        EvalPose gt;
+    };
+
+    int64_t window_ns_;
+    int64_t min_spacing_ns_;
+    Entry   ring_[kHistory];
+    size_t  head_  = 0;
+    size_t  count_ = 0;
+
+    size_t n_         = 0;
+    double trans_sq_  = 0.0;
+    double trans_max_ = 0.0;
+    double rot_sq_    = 0.0;
+    double rot_max_   = 0.0;
+
+    const Entry& at(size_t i) const { return ring_[(head_ + i) % kHistory]; }
+    const Entry& oldest()     const { return at(0); }
+    const Entry& newest()     const { return at(count_ - 1); }
+
+    void pop() {
+        head_ = (head_ + 1) % kHistory;
+        --count_;
+    }
+
+    // Motion from a to b expressed in a's body frame.
+    static EvalPose relative(const EvalPose& a, const EvalPose& b) {
+        Eigen::Quaterniond a_inv = a.q.conjugate();
+        return EvalPose{a_inv * (b.p - a.p), a_inv * b.q};
+    }
+
+    void accumulate(const EvalPose& est, const EvalPose& gt) {
+        double te = (gt.p - est.p).norm();
+        double re = gt.q.angularDistance(est.q) * 180.0 / M_PI;
+        ++n_;
+        trans_sq_ += te * te;
+        rot_sq_   += re * re;
+        if (te > trans_max_) trans_max_ = te;
+        if (re > rot_max_)   rot_max_   = re;
+    }
+};
+
+} // namespace ILLIXR
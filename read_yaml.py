@@ -44,6 +44,75 @@ enable_alignment = as_bool(data.get("enable_alignment", False))
 verbose_errors   = as_bool(data.get("enable_verbose_errors", False))
 enable_pre_sleep = as_bool(data.get("enable_pre_sleep", False))
 
+# Camera overload policy (offline_cam) when openvins falls behind
+CAM_DROP_POLICIES = ["strict", "skip_to_latest", "decimate"]
+cam_drop_policy = str(data.get("cam_drop_policy", "strict")).strip().lower()
+if cam_drop_policy not in CAM_DROP_POLICIES:
+    print(f"[read_yaml] cam_drop_policy must be one of {CAM_DROP_POLICIES}, got '{cam_drop_policy}'")
+    sys.exit(1)
+cam_decimate_n = int(data.get("cam_decimate_n", 2))
+if cam_decimate_n < 1:
+    print(f"[read_yaml] cam_decimate_n must be >= 1, got {cam_decimate_n}")
+    sys.exit(1)
+cam_time_scale = float(data.get("cam_time_scale", 1.0))
+if cam_time_scale <= 0.0:
+    print(f"[read_yaml] cam_time_scale must be > 0, got {cam_time_scale}")
+    sys.exit(1)
+cam_prefetch_depth = int(data.get("cam_prefetch_depth", 2))
+if cam_prefetch_depth < 0:
+    print(f"[read_yaml] cam_prefetch_depth must be >= 0, got {cam_prefetch_depth}")
+    sys.exit(1)
+
+# Online trajectory evaluation (trajectory_eval)
+eval_rpe_window_s = float(data.get("eval_rpe_window_s", 1.0))
+if eval_rpe_window_s <= 0.0:
+    print(f"[read_yaml] eval_rpe_window_s must be > 0, got {eval_rpe_window_s}")
+    sys.exit(1)
+eval_align_scale  = as_bool(data.get("eval_align_scale", False))
+eval_report_every = int(data.get("eval_report_every", 50))
+if eval_report_every < 0:
+    print(f"[read_yaml] eval_report_every must be >= 0, got {eval_report_every}")
+    sys.exit(1)
+
+# Frames openvins processes before stopping (0 = until the camera stream ends)
+vio_max_frames = int(data.get("vio_max_frames", 50))
+if vio_max_frames < 0:
+    print(f"[read_yaml] vio_max_frames must be >= 0, got {vio_max_frames}")
+    sys.exit(1)
+
+# openvins temporal tracker: full-resolution box search, coarse-to-fine NCC
+# pyramid, or Lucas-Kanade on the pyramid
+VIO_TRACKERS = ["box", "pyramid", "lk"]
+vio_tracker = str(data.get("vio_tracker", "box")).strip().lower()
+if vio_tracker not in VIO_TRACKERS:
+    print(f"[read_yaml] vio_tracker must be one of {VIO_TRACKERS}, got '{vio_tracker}'")
+    sys.exit(1)
+vio_pyramid_levels = int(data.get("vio_pyramid_levels", 4))
+if not 2 <= vio_pyramid_levels <= 5:
+    print(f"[read_yaml] vio_pyramid_levels must be in [2, 5], got {vio_pyramid_levels}")
+    sys.exit(1)
+vio_imu_predict = as_bool(data.get("vio_imu_predict", True))
+vio_rectify_stereo = as_bool(data.get("vio_rectify_stereo", False))
+
+# Synthetic sensor generator (synthetic_sensors)
+synth_imu_rate_hz = int(data.get("synth_imu_rate_hz", 200))
+if not 1 <= synth_imu_rate_hz <= 1000:
+    print(f"[read_yaml] synth_imu_rate_hz must be in [1, 1000], got {synth_imu_rate_hz}")
+    sys.exit(1)
+synth_cam_fps = float(data.get("synth_cam_fps", 20.0))
+if not 0.0 < synth_cam_fps <= synth_imu_rate_hz:
+    print(f"[read_yaml] synth_cam_fps must be in (0, synth_imu_rate_hz], got {synth_cam_fps}")
+    sys.exit(1)
+synth_width  = int(data.get("synth_width", 752))
+synth_height = int(data.get("synth_height", 480))
+if synth_width < 16 or synth_height < 16:
+    print(f"[read_yaml] synth_width/synth_height must be >= 16, got {synth_width}x{synth_height}")
+    sys.exit(1)
+synth_duration_s = float(data.get("synth_duration_s", 10.0))
+if synth_duration_s <= 0.0:
+    print(f"[read_yaml] synth_duration_s must be > 0, got {synth_duration_s}")
+    sys.exit(1)
+
 # Emit header
 header = textwrap.dedent(f"""\
     // Auto-generated from {yaml_path}
@@ -55,6 +124,25 @@ header = textwrap.dedent(f"""\
     constexpr bool ENABLE_ALIGNMENT = {"true" if enable_alignment else "false"};
     constexpr bool ENABLE_VERBOSE_ERRORS = {"true" if verbose_errors else "false"};
     constexpr bool ENABLE_PRE_SLEEP = {"true" if enable_pre_sleep else "false"};
+    enum class CamDropPolicy {{ strict, skip_to_latest, decimate }};
+    constexpr CamDropPolicy CAM_DROP_POLICY = CamDropPolicy::{cam_drop_policy};
+    constexpr int CAM_DECIMATE_N = {cam_decimate_n};
+    constexpr double CAM_TIME_SCALE = {cam_time_scale!r};
+    constexpr int CAM_PREFETCH_DEPTH = {cam_prefetch_depth};
+    constexpr double EVAL_RPE_WINDOW_S = {eval_rpe_window_s!r};
+    constexpr bool EVAL_ALIGN_SCALE = {"true" if eval_align_scale else "false"};
+    constexpr int EVAL_REPORT_EVERY = {eval_report_every};
+    constexpr int VIO_MAX_FRAMES = {vio_max_frames};
+    enum class VioTracker {{ box, pyramid, lk }};
+    constexpr VioTracker VIO_TRACKER = VioTracker::{vio_tracker};
+    constexpr int VIO_PYRAMID_LEVELS = {vio_pyramid_levels};
+    constexpr bool VIO_IMU_PREDICT = {"true" if vio_imu_predict else "false"};
+    constexpr bool VIO_RECTIFY_STEREO = {"true" if vio_rectify_stereo else "false"};
+    constexpr int SYNTH_IMU_RATE_HZ = {synth_imu_rate_hz};
+    constexpr double SYNTH_CAM_FPS = {synth_cam_fps!r};
+    constexpr int SYNTH_WIDTH = {synth_width};
+    constexpr int SYNTH_HEIGHT = {synth_height};
+    constexpr double SYNTH_DURATION_S = {synth_duration_s!r};
     constexpr const char* PLUGINS[] = {{
         {", ".join(f'"{p}"' for p in plugins)}, nullptr
     }};
@@ -1,18 +1,32 @@
+#pragma once
+
 #include <relative_clock.hpp>
 #include <Eigen/Dense>
+#include <cstdint>
 // in ../../src/data_format.hpp (approx)
 namespace ILLIXR {
     using ullong = unsigned long long;
 
+    // Where a message's data came from. Stamped once by the producer and
+    // copied forward unchanged, so a pose can be traced back to its sensor
+    // sample (see latency_tracker.hpp).
+    struct Provenance {
+        int64_t  dataset_ts_ns = 0;  // source sample's dataset timestamp
+        uint64_t ingest_mtime  = 0;  // CLINT mtime when the producer emitted it
+        uint32_t seq           = 0;  // producer's sample/frame index
+    };
+
     struct ImuMsg {
         time_point      time;
         Eigen::Vector3d angular_v;
         Eigen::Vector3d linear_a;
+        Provenance      prov;
     };
     struct PoseMsg {
         time_point timestamp;
         Eigen::Vector3f position;        // [x, y, z] meters
         Eigen::Quaternionf orientation;  // (w, x, y, z)
+        Provenance prov;
     };
     struct ImuParams {
         double gyro_noise;           // Gyro white noise
@@ -32,6 +46,7 @@ namespace ILLIXR {
         Eigen::Vector3d position;      // Current full state
         Eigen::Vector3d velocity;
         Eigen::Quaterniond orientation;
+        Provenance prov;               // camera frame this state was updated from
     };
 
 }
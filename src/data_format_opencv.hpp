@@ -1,5 +1,8 @@
+#pragma once
+
 #include <relative_clock.hpp>
 #include <Eigen/Dense>
+#include "data_format.hpp"
 // in ../../src/data_format.hpp (approx)
 namespace ILLIXR {
     using ullong = unsigned long long;
@@ -8,6 +11,8 @@ namespace ILLIXR {
         time_point      time;
         cv::Mat         img0;
         cv::Mat         img1;
+        Provenance      prov;
+        bool            pre_equalized = false;  // histogram-equalized offline
     };
 
 }
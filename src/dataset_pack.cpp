@@ -0,0 +1,48 @@
+#include "dataset_pack.hpp"
+
+#include <cstdio>
+
+#if defined(ILLIXR_DATASET_PACK_EMBEDDED)
+// ILLIXR_DATASET_PACK, placed by src/dataset_pack_blob.S (64-byte aligned).
+extern "C" const uint8_t illixr_dataset_pack_start[];
+extern "C" const uint8_t illixr_dataset_pack_end[];
+#elif defined(ILLIXR_DATASET_PACK_FS_PATH) && !defined(CONFIG_FILE_SYSTEM)
+#error "ILLIXR_DATASET_PACK_FS_PATH needs CONFIG_FILE_SYSTEM=y (pack_fs.conf, merged by CMakeLists.txt)"
+#endif
+
+namespace ILLIXR {
+
+const pack::Reader& get_dataset_pack() {
+    static pack::Reader reader;
+    static bool         opened = false;
+    if (opened) return reader;
+    opened = true;
+
+#if defined(ILLIXR_DATASET_PACK_EMBEDDED)
+    static pack::MemorySource source{
+        illixr_dataset_pack_start,
+        static_cast<size_t>(illixr_dataset_pack_end - illixr_dataset_pack_start)};
+    const char* where = "embedded blob";
+    bool        ok    = reader.open(&source);
+#elif defined(ILLIXR_DATASET_PACK_FS_PATH)
+    static pack::FsSource source;
+    const char* where = ILLIXR_DATASET_PACK_FS_PATH;
+    bool        ok    = source.open(where) && reader.open(&source);
+#else
+    const char* where = "(none configured)";
+    bool        ok    = false;
+#endif
+
+    if (ok) {
+        const pack::Header& h = reader.header();
+        printf("[dataset_pack] %s: %u chunks  imu_chunks=%zu  frames=%zu  cam=%ux%u %s\n",
+               where, h.chunk_count, reader.chunks(pack::Stream::imu),
+               reader.chunks(pack::Stream::cam0), h.cam_width, h.cam_height,
+               h.cam_encoding == static_cast<uint32_t>(pack::CamEncoding::png) ? "png" : "raw");
+    } else {
+        printf("[dataset_pack] ERROR: could not open %s\n", where);
+    }
+    return reader;
+}
+
+} // namespace ILLIXR
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "helper/illixrpack.hpp"
+
+// ==============================================================================
+// DATASET PACK — the .illixrpack the offline sensor plugins replay
+//
+// Built only when CMake is given a pack (see CMakeLists.txt):
+//   -DILLIXR_DATASET_PACK=<file.illixrpack>   embedded into the image
+//   -DILLIXR_DATASET_PACK_FS_PATH=/lfs/x.illixrpack   read from littlefs
+// Both define ILLIXR_DATASET_PACK; without it offline_imu / offline_cam use
+// the generated embedded_*.hpp headers as before. The littlefs volume is on
+// the illixr_pack_partition flash partition (boards/<board>_pack_fs.overlay)
+// and main() mounts it before the plugins start.
+// ==============================================================================
+
+namespace ILLIXR {
+
+// Opened on first call. Plugins call it from their constructors, which the
+// runtime runs one after another on the main thread. Check ok() — a pack
+// that fails to open reads as empty.
+const pack::Reader& get_dataset_pack();
+
+} // namespace ILLIXR
+
+#ifdef ILLIXR_DATASET_PACK_FS_PATH
+// src/dataset_pack_fs.c: mounts the volume read-only at
+// ILLIXR_DATASET_PACK_FS_MOUNT. 0 on success, else the fs_mount() error.
+extern "C" int illixr_mount_dataset_pack_fs(void);
+#endif
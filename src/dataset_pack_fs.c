@@ -0,0 +1,38 @@
+// Mounts the littlefs volume that ILLIXR_DATASET_PACK_FS_PATH lives on (see
+// src/dataset_pack.hpp). Kconfig comes from pack_fs.conf, the partition from
+// boards/<board>_pack_fs.overlay.
+//
+// C rather than C++: FS_LITTLEFS_DECLARE_DEFAULT_CONFIG and fs_mount_t are
+// set up with C designated initialisers.
+
+#include <stdio.h>
+
+#include <zephyr/fs/fs.h>
+#include <zephyr/fs/littlefs.h>
+#include <zephyr/storage/flash_map.h>
+
+#if !DT_NODE_EXISTS(DT_NODELABEL(illixr_pack_partition))
+#error "ILLIXR_DATASET_PACK_FS_PATH needs an illixr_pack_partition (boards/<board>_pack_fs.overlay); embed the pack with ILLIXR_DATASET_PACK on other boards"
+#endif
+
+FS_LITTLEFS_DECLARE_DEFAULT_CONFIG(illixr_pack_lfs);
+
+static struct fs_mount_t illixr_pack_mount = {
+    .type        = FS_LITTLEFS,
+    .mnt_point   = ILLIXR_DATASET_PACK_FS_MOUNT,
+    .fs_data     = &illixr_pack_lfs,
+    .storage_dev = (void *)FIXED_PARTITION_ID(illixr_pack_partition),
+    .flags       = FS_MOUNT_FLAG_READ_ONLY | FS_MOUNT_FLAG_NO_FORMAT,
+};
+
+int illixr_mount_dataset_pack_fs(void) {
+    int rc = fs_mount(&illixr_pack_mount);
+    if (rc != 0) {
+        printf("[dataset_pack] ERROR: mounting littlefs at %s failed rc=%d\n",
+               ILLIXR_DATASET_PACK_FS_MOUNT, rc);
+    } else {
+        printf("[dataset_pack] littlefs mounted read-only at %s\n",
+               ILLIXR_DATASET_PACK_FS_MOUNT);
+    }
+    return rc;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "data_format.hpp"
+
+// ==============================================================================
+// GROUND TRUTH — dataset pose lookup for the native runtime
+//
+// Provided by the ground_truth plugin (plugins/ground_truth) from the
+// state_groundtruth_estimate0 stream of the .illixrpack, replacing the
+// switchboard-era pose_lookup / ground_truth_slam plugins.
+//
+//   auto* gt = pb.lookup_impl<GroundTruth>();   // lazily, see below
+//   PoseMsg pose;
+//   if (gt && gt->pose_at(t_ns, pose)) ...
+//
+// The plugin also republishes, for every openvins pose, the ground truth at
+// the same timestamp on the "true_pose" channel (sender "ground_truth"), with
+// the openvins provenance so the two can be paired.
+//
+// The provider registers from its constructor, and plugins are constructed and
+// started one at a time, so it may not exist yet in another plugin's
+// constructor or _p_thread_setup(). Look it up from the callback that needs
+// it and retry while lookup_impl() returns nullptr (plugins/trajectory_eval).
+// ==============================================================================
+
+namespace ILLIXR {
+
+class GroundTruth {
+public:
+    virtual ~GroundTruth() = default;
+
+    // Body pose in the dataset world frame at dataset time t_ns: position
+    // interpolated linearly, orientation by SLERP. False outside the
+    // ground-truth time span (or when the pack has none).
+    virtual bool pose_at(int64_t t_ns, PoseMsg& out) const = 0;
+
+    virtual bool    available()   const = 0;
+    virtual int64_t first_ts_ns() const = 0;
+    virtual int64_t last_ts_ns()  const = 0;
+};
+
+} // namespace ILLIXR
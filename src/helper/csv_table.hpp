@@ -0,0 +1,172 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// ==============================================================================
+// CSV TABLE — in-place parser for EuRoC-style numeric CSVs
+//
+// Replaces CSVIterator (one stringstream per line, one std::string per cell)
+// for the data.csv loaders. The whole file is parsed from one buffer:
+// fields are string_views into it and numbers go through std::from_chars,
+// straight into a columnar table:
+//
+//   ts       ascending uint64 timestamps (column 0 of the file)
+//   col(c)   contiguous values of file column c+1
+//
+// Storage is reserved once from a newline count, so parsing allocates nothing
+// per row. EuRoC files are already sorted; anything else is sorted once at
+// the end, and duplicate timestamps keep the last row (the std::map
+// `data[t] = ...` behaviour of the old loaders).
+// ==============================================================================
+
+namespace ILLIXR {
+namespace csv {
+
+class Table {
+public:
+    std::vector<uint64_t> ts;
+
+    size_t rows()    const { return ts.size(); }
+    size_t columns() const { return columns_; }
+
+    const double* col(size_t c) const { return values_.data() + c * capacity_; }
+    double        at(size_t c, size_t row) const { return values_[c * capacity_ + row]; }
+
+    // Rows rejected for a bad timestamp or too few numeric fields.
+    size_t skipped() const { return skipped_; }
+
+private:
+    friend bool parse(std::string_view, size_t, Table&, size_t);
+
+    // Column-major: column c occupies [c * capacity_, c * capacity_ + rows()).
+    std::vector<double> values_;
+    size_t              columns_  = 0;
+    size_t              capacity_ = 0;
+    size_t              skipped_  = 0;
+};
+
+namespace detail {
+
+inline bool is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v';
+}
+
+inline std::string_view trim(std::string_view s) {
+    while (!s.empty() && is_space(s.front())) s.remove_prefix(1);
+    while (!s.empty() && is_space(s.back()))  s.remove_suffix(1);
+    return s;
+}
+
+// Next comma-separated field of `line`, consumed from the front.
+inline std::string_view next_field(std::string_view& line) {
+    size_t           comma = line.find(',');
+    std::string_view field = line.substr(0, comma);
+    line.remove_prefix(comma == std::string_view::npos ? line.size() : comma + 1);
+    return trim(field);
+}
+
+template <typename T>
+inline bool to_number(std::string_view s, T& out) {
+    if (!s.empty() && s.front() == '+') s.remove_prefix(1);
+    const char* end = s.data() + s.size();
+    auto        r   = std::from_chars(s.data(), end, out);
+    return r.ec == std::errc{} && r.ptr == end;
+}
+
+} // namespace detail
+
+// Parses `text` into `out`: a timestamp column followed by `value_columns`
+// numeric columns; extra columns are ignored. The first `skip_rows` lines
+// (the EuRoC header) and any line starting with '#' or blank are skipped.
+// Returns false only if no row could be parsed.
+inline bool parse(std::string_view text, size_t value_columns, Table& out, size_t skip_rows = 1) {
+    size_t lines = static_cast<size_t>(std::count(text.begin(), text.end(), '\n')) + 1;
+
+    out.ts.clear();
+    out.ts.reserve(lines);
+    out.columns_  = value_columns;
+    out.capacity_ = lines;
+    out.skipped_  = 0;
+    out.values_.assign(value_columns * lines, 0.0);
+
+    size_t row = 0;
+    while (!text.empty()) {
+        size_t           nl   = text.find('\n');
+        std::string_view line = text.substr(0, nl);
+        text.remove_prefix(nl == std::string_view::npos ? text.size() : nl + 1);
+
+        if (skip_rows > 0) {
+            --skip_rows;
+            continue;
+        }
+        line = detail::trim(line);
+        if (line.empty() || line.front() == '#') continue;
+
+        uint64_t t;
+        if (!detail::to_number(detail::next_field(line), t)) {
+            ++out.skipped_;
+            continue;
+        }
+
+        size_t c = 0;
+        for (; c < value_columns; c++) {
+            if (!detail::to_number(detail::next_field(line), out.values_[c * lines + row])) break;
+        }
+        if (c < value_columns) {
+            ++out.skipped_;
+            continue;
+        }
+
+        out.ts.push_back(t);
+        ++row;
+    }
+
+    if (!std::is_sorted(out.ts.begin(), out.ts.end()) ||
+        std::adjacent_find(out.ts.begin(), out.ts.end()) != out.ts.end()) {
+        // Rare path: sort a permutation, keep the last row of each timestamp.
+        std::vector<size_t> order(row);
+        std::iota(order.begin(), order.end(), size_t{0});
+        std::stable_sort(order.begin(), order.end(),
+                         [&](size_t a, size_t b) { return out.ts[a] < out.ts[b]; });
+
+        std::vector<uint64_t> ts;
+        std::vector<double>   values(value_columns * lines, 0.0);
+        ts.reserve(row);
+        for (size_t i = 0; i < row; i++) {
+            size_t src = order[i];
+            if (i + 1 < row && out.ts[order[i + 1]] == out.ts[src]) continue;
+            for (size_t c = 0; c < value_columns; c++)
+                values[c * lines + ts.size()] = out.values_[c * lines + src];
+            ts.push_back(out.ts[src]);
+        }
+        out.ts.swap(ts);
+        out.values_.swap(values);
+    }
+
+    return !out.ts.empty();
+}
+
+// Reads a whole file into `buffer` (one allocation) and parses it.
+inline bool load_file(const std::string& path, size_t value_columns, Table& out,
+                      std::string& buffer, size_t skip_rows = 1) {
+    std::ifstream file{path, std::ios::binary | std::ios::ate};
+    if (!file.good()) return false;
+    std::streamsize size = file.tellg();
+    if (size < 0) return false;
+    buffer.resize(static_cast<size_t>(size));
+    file.seekg(0);
+    if (!file.read(buffer.data(), size)) return false;
+    return parse(buffer, value_columns, out, skip_rows);
+}
+
+} // namespace csv
+} // namespace ILLIXR
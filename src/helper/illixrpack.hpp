@@ -0,0 +1,299 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "lz4_block.hpp"
+
+#ifdef CONFIG_FILE_SYSTEM
+#include <zephyr/kernel.h>
+#include <zephyr/fs/fs.h>
+#endif
+
+// ==============================================================================
+// .illixrpack — chunked dataset container (written by pack_euroc_data.py)
+//
+// Layout, all little-endian:
+//
+//   Header       40 B   magic "ILXPACK1", version, chunk count, index offset,
+//                       camera encoding + size, IMU record size
+//   chunk data   ...    each chunk stored raw or as one LZ4 block, 64-B aligned
+//   ChunkEntry[] 40 B   one per chunk, at header.index_offset, in file order
+//
+// Streams:
+//   imu  : chunks of ImuRecord (ts + float gyro/accel), a few hundred per chunk
+//   cam0 : one chunk per image, same order as cam1 (chunk n of cam0 and cam1
+//   cam1   form stereo frame n). Image bytes are a PNG file or raw GRAY8
+//          (width x height, no padding), depending on header.cam_encoding.
+//   gt   : chunks of GroundTruthRecord (state_groundtruth_estimate0 pose),
+//          optional; packs without it simply have no gt chunks
+//
+// The reader keeps only the header and index in RAM and loads one chunk at a
+// time, so a full EuRoC sequence replays without compiling it into headers.
+// The bytes come from a Source: a linker-embedded blob (MemorySource, which
+// hands out pointers into ROM for uncompressed chunks) or a file on a Zephyr
+// filesystem partition (FsSource, CONFIG_FILE_SYSTEM).
+// ==============================================================================
+
+namespace ILLIXR {
+namespace pack {
+
+constexpr char     kMagic[8] = {'I', 'L', 'X', 'P', 'A', 'C', 'K', '1'};
+constexpr uint32_t kVersion  = 1;
+
+enum class Stream : uint8_t { imu = 0, cam0 = 1, cam1 = 2, gt = 3, count };
+enum class Codec  : uint8_t { none = 0, lz4 = 1 };
+enum class CamEncoding : uint32_t { png = 0, raw_gray8 = 1 };
+
+struct Header {
+    char     magic[8];
+    uint32_t version;
+    uint32_t chunk_count;
+    uint64_t index_offset;
+    uint32_t cam_encoding;     // CamEncoding
+    uint32_t cam_width;
+    uint32_t cam_height;
+    uint32_t imu_record_size;  // sizeof(ImuRecord), for forward compatibility
+};
+static_assert(sizeof(Header) == 40, "illixrpack header layout");
+
+struct ChunkEntry {
+    uint8_t  stream;       // Stream
+    uint8_t  codec;        // Codec
+    uint16_t records;      // IMU samples in the chunk (1 for images)
+    uint32_t raw_size;     // bytes after decompression
+    uint64_t offset;       // from start of file
+    uint32_t stored_size;  // bytes in the file
+    uint32_t reserved;
+    int64_t  first_ts_ns;
+    int64_t  last_ts_ns;
+};
+static_assert(sizeof(ChunkEntry) == 40, "illixrpack index layout");
+
+struct ImuRecord {
+    int64_t ts_ns;
+    float   w[3];  // rad/s
+    float   a[3];  // m/s^2
+};
+static_assert(sizeof(ImuRecord) == 32, "illixrpack IMU record layout");
+
+struct GroundTruthRecord {
+    int64_t  ts_ns;
+    float    p[3];   // body position in world, m
+    float    q[4];   // body-to-world orientation, w x y z
+    uint32_t reserved;
+};
+static_assert(sizeof(GroundTruthRecord) == 40, "illixrpack ground-truth record layout");
+
+// =============================================================================
+// SOURCES
+// =============================================================================
+
+class Source {
+public:
+    virtual ~Source() = default;
+    virtual bool read(uint64_t offset, void* dst, size_t len) = 0;
+    // Direct pointer to [offset, offset+len) if the bytes are memory-mapped.
+    virtual const uint8_t* map(uint64_t, size_t) { return nullptr; }
+};
+
+class MemorySource : public Source {
+public:
+    MemorySource(const uint8_t* data, size_t size) : data_{data}, size_{size} { }
+
+    bool read(uint64_t offset, void* dst, size_t len) override {
+        const uint8_t* p = map(offset, len);
+        if (!p) return false;
+        std::memcpy(dst, p, len);
+        return true;
+    }
+
+    const uint8_t* map(uint64_t offset, size_t len) override {
+        if (offset > size_ || len > size_ - offset) return nullptr;
+        return data_ + offset;
+    }
+
+private:
+    const uint8_t* data_;
+    size_t         size_;
+};
+
+#ifdef CONFIG_FILE_SYSTEM
+// Shared by the IMU and camera threads, so seek+read is done under a mutex.
+class FsSource : public Source {
+public:
+    FsSource() : open_{false} {
+        fs_file_t_init(&file_);
+        k_mutex_init(&lock_);
+    }
+    ~FsSource() override {
+        if (open_) fs_close(&file_);
+    }
+
+    bool open(const char* path) {
+        open_ = fs_open(&file_, path, FS_O_READ) == 0;
+        return open_;
+    }
+
+    bool read(uint64_t offset, void* dst, size_t len) override {
+        if (!open_) return false;
+        k_mutex_lock(&lock_, K_FOREVER);
+        bool ok = fs_seek(&file_, static_cast<off_t>(offset), FS_SEEK_SET) == 0 &&
+                  fs_read(&file_, dst, len) == static_cast<ssize_t>(len);
+        k_mutex_unlock(&lock_);
+        return ok;
+    }
+
+private:
+    struct fs_file_t file_;
+    struct k_mutex   lock_;
+    bool             open_;
+};
+#endif // CONFIG_FILE_SYSTEM
+
+// =============================================================================
+// READER
+// =============================================================================
+
+class Reader {
+public:
+    Reader() : src_{nullptr}, header_{} { }
+
+    // Validates the header and loads the index. Safe to share between threads
+    // afterwards: everything below is read-only apart from the Source.
+    bool open(Source* src) {
+        src_ = src;
+        for (auto& v : by_stream_) v.clear();
+        index_.clear();
+
+        if (!src_ || !src_->read(0, &header_, sizeof(header_))) return false;
+        if (std::memcmp(header_.magic, kMagic, sizeof(kMagic)) != 0 ||
+            header_.version != kVersion ||
+            header_.imu_record_size != sizeof(ImuRecord)) {
+            src_ = nullptr;
+            return false;
+        }
+
+        index_.resize(header_.chunk_count);
+        if (!src_->read(header_.index_offset, index_.data(),
+                        index_.size() * sizeof(ChunkEntry))) {
+            src_ = nullptr;
+            return false;
+        }
+        for (uint32_t i = 0; i < header_.chunk_count; i++) {
+            if (index_[i].stream < static_cast<uint8_t>(Stream::count))
+                by_stream_[index_[i].stream].push_back(i);
+        }
+        return true;
+    }
+
+    bool          ok()     const { return src_ != nullptr; }
+    const Header& header() const { return header_; }
+
+    size_t chunks(Stream s) const { return by_stream_[static_cast<size_t>(s)].size(); }
+
+    // n-th chunk of a stream, in timestamp order.
+    const ChunkEntry& chunk(Stream s, size_t n) const {
+        return index_[by_stream_[static_cast<size_t>(s)][n]];
+    }
+
+    // Stored (possibly compressed) bytes of a chunk: a pointer into the
+    // source when it is memory-mapped, otherwise read into `scratch`.
+    const uint8_t* stored(const ChunkEntry& e, std::vector<uint8_t>& scratch) const {
+        if (!src_) return nullptr;
+        if (const uint8_t* p = src_->map(e.offset, e.stored_size)) return p;
+        scratch.resize(e.stored_size);
+        return src_->read(e.offset, scratch.data(), e.stored_size) ? scratch.data() : nullptr;
+    }
+
+    // Decompressed bytes of a chunk (raw_size long). Uncompressed chunks are
+    // returned in place when possible; LZ4 chunks are expanded into `out`.
+    const uint8_t* load(const ChunkEntry& e, std::vector<uint8_t>& scratch,
+                        std::vector<uint8_t>& out) const {
+        const uint8_t* p = stored(e, scratch);
+        if (!p || e.codec == static_cast<uint8_t>(Codec::none)) return p;
+        if (e.codec != static_cast<uint8_t>(Codec::lz4)) return nullptr;
+
+        out.resize(e.raw_size);
+        long n = lz4_block_decompress(p, e.stored_size, out.data(), out.size());
+        return n == static_cast<long>(e.raw_size) ? out.data() : nullptr;
+    }
+
+private:
+    Source*                 src_;
+    Header                  header_;
+    std::vector<ChunkEntry> index_;
+    std::vector<uint32_t>   by_stream_[static_cast<size_t>(Stream::count)];
+};
+
+// =============================================================================
+// IMU CURSOR — forward iteration over every IMU record, one chunk resident
+// =============================================================================
+
+class ImuCursor {
+public:
+    explicit ImuCursor(const Reader& reader)
+        : reader_{reader}, chunk_{0}, in_chunk_{0}, index_{0}, size_{0}, records_{nullptr} {
+        for (size_t c = 0; c < reader_.chunks(Stream::imu); c++)
+            size_ += reader_.chunk(Stream::imu, c).records;
+        load_chunk();
+    }
+
+    size_t  size()  const { return size_; }
+    bool    done()  const { return records_ == nullptr; }
+    size_t  index() const { return index_; }
+    int64_t ts_ns() const { return record().ts_ns; }
+
+    int64_t first_ts_ns() const {
+        return reader_.chunks(Stream::imu) ? reader_.chunk(Stream::imu, 0).first_ts_ns : 0;
+    }
+
+    void read(double w[3], double a[3]) const {
+        const ImuRecord& r = record();
+        for (int c = 0; c < 3; c++) {
+            w[c] = r.w[c];
+            a[c] = r.a[c];
+        }
+    }
+
+    void advance() {
+        ++index_;
+        if (++in_chunk_ < reader_.chunk(Stream::imu, chunk_).records) return;
+        ++chunk_;
+        in_chunk_ = 0;
+        load_chunk();
+    }
+
+private:
+    const Reader&        reader_;
+    size_t               chunk_;
+    size_t               in_chunk_;
+    size_t               index_;
+    size_t               size_;
+    const uint8_t*       records_;   // nullptr once past the last chunk
+    std::vector<uint8_t> scratch_, out_;
+
+    // Records may sit at any alignment in a memory-mapped pack, so copy out.
+    const ImuRecord& record() const {
+        std::memcpy(&current_, records_ + in_chunk_ * sizeof(ImuRecord), sizeof(ImuRecord));
+        return current_;
+    }
+    mutable ImuRecord current_;
+
+    void load_chunk() {
+        records_ = nullptr;
+        while (chunk_ < reader_.chunks(Stream::imu)) {
+            const ChunkEntry& e = reader_.chunk(Stream::imu, chunk_);
+            if (e.records > 0 && e.raw_size >= e.records * sizeof(ImuRecord)) {
+                records_ = reader_.load(e, scratch_, out_);
+                if (records_) return;
+            }
+            ++chunk_;   // empty or unreadable chunk: skip it
+        }
+    }
+};
+
+} // namespace pack
+} // namespace ILLIXR
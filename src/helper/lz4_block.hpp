@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// Decoder for the LZ4 *block* format (no frame header / checksums), as written
+// by embed_euroc_data.py --cam-format lz4 and lz4.block.compress(store_size=False).
+//
+// Each sequence is: token, [literal length bytes], literals,
+// 2-byte little-endian match offset, [match length bytes]. The last sequence
+// carries literals only.
+//
+// Returns the number of bytes written to dst, or -1 if the input is malformed
+// or would overflow dst_cap.
+inline long lz4_block_decompress(const uint8_t* src, size_t src_size,
+                                 uint8_t* dst, size_t dst_cap) {
+    const uint8_t* ip     = src;
+    const uint8_t* ip_end = src + src_size;
+    uint8_t*       op     = dst;
+    uint8_t*       op_end = dst + dst_cap;
+
+    while (ip < ip_end) {
+        uint8_t token = *ip++;
+
+        // ── literals ──────────────────────────────────────────────────────
+        size_t lit_len = token >> 4;
+        if (lit_len == 15) {
+            uint8_t b;
+            do {
+                if (ip >= ip_end) return -1;
+                b = *ip++;
+                lit_len += b;
+            } while (b == 255);
+        }
+        if (lit_len > static_cast<size_t>(ip_end - ip) ||
+            lit_len > static_cast<size_t>(op_end - op)) return -1;
+        std::memcpy(op, ip, lit_len);
+        ip += lit_len;
+        op += lit_len;
+
+        if (ip == ip_end) break;  // last sequence: literals only
+
+        // ── match ─────────────────────────────────────────────────────────
+        if (ip_end - ip < 2) return -1;
+        size_t offset = static_cast<size_t>(ip[0]) | (static_cast<size_t>(ip[1]) << 8);
+        ip += 2;
+        if (offset == 0 || offset > static_cast<size_t>(op - dst)) return -1;
+
+        size_t match_len = (token & 0x0F) + 4;
+        if ((token & 0x0F) == 15) {
+            uint8_t b;
+            do {
+                if (ip >= ip_end) return -1;
+                b = *ip++;
+                match_len += b;
+            } while (b == 255);
+        }
+        if (match_len > static_cast<size_t>(op_end - op)) return -1;
+
+        // Matches may overlap their own output (offset < length), so copy
+        // forward byte by byte in that case.
+        const uint8_t* match = op - offset;
+        if (offset >= match_len) {
+            std::memcpy(op, match, match_len);
+            op += match_len;
+        } else {
+            for (size_t i = 0; i < match_len; i++) *op++ = *match++;
+        }
+    }
+
+    return static_cast<long>(op - dst);
+}
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "csv_table.hpp"
+
+// ==============================================================================
+// TIME SERIES — sorted timestamps + SoA payload
+//
+// Replaces the std::map<ullong, sensor_types> the dataset loaders built: one
+// contiguous timestamp array and one contiguous array per channel, instead of
+// a heap node per sample.
+//
+// Lookups:
+//   floor_index(t)        last sample at or before t, O(log n)
+//   floor_index(t, hint)  same, O(1) when t moved little since `hint`
+//   find(t)               exact timestamp match
+//   bracket(t)            neighbours + blend factor, for interpolation
+//   Cursor                holds the hint for one monotonic reader
+//
+// Channels are interpolated linearly. Callers that store quaternions blend
+// the bracket themselves (SLERP, or LERP + normalize).
+// ==============================================================================
+
+namespace ILLIXR {
+
+template <size_t Channels, typename T = float>
+class TimeSeries {
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    struct Bracket {
+        size_t lo;
+        size_t hi;     // == lo when t is outside the series
+        T      alpha;  // weight of hi
+    };
+
+    void reserve(size_t n) {
+        ts_.reserve(n);
+        for (auto& c : values_) c.reserve(n);
+    }
+
+    // Samples must be appended in increasing timestamp order.
+    void push_back(uint64_t t, const std::array<T, Channels>& v) {
+        ts_.push_back(t);
+        for (size_t c = 0; c < Channels; c++) values_[c].push_back(v[c]);
+    }
+
+    // Takes file columns [first_column, first_column + Channels) of a parsed
+    // CSV; the table is already sorted and free of duplicate timestamps.
+    static TimeSeries from_table(csv::Table&& table, size_t first_column = 0) {
+        TimeSeries s;
+        s.ts_ = std::move(table.ts);
+        for (size_t c = 0; c < Channels; c++) {
+            const double* src = table.col(first_column + c);
+            s.values_[c].assign(src, src + s.ts_.size());
+        }
+        return s;
+    }
+
+    size_t   size()  const { return ts_.size(); }
+    bool     empty() const { return ts_.empty(); }
+    uint64_t time(size_t i) const { return ts_[i]; }
+    uint64_t front_time() const { return ts_.front(); }
+    uint64_t back_time()  const { return ts_.back(); }
+
+    T        value(size_t c, size_t i) const { return values_[c][i]; }
+    const T* channel(size_t c) const { return values_[c].data(); }
+
+    std::array<T, Channels> row(size_t i) const {
+        std::array<T, Channels> v;
+        for (size_t c = 0; c < Channels; c++) v[c] = values_[c][i];
+        return v;
+    }
+
+    // Index of the last sample with time <= t; 0 if t precedes the series.
+    size_t floor_index(uint64_t t) const {
+        auto it = std::upper_bound(ts_.begin(), ts_.end(), t);
+        return it == ts_.begin() ? 0 : static_cast<size_t>(it - ts_.begin()) - 1;
+    }
+
+    // As above, starting from a previous answer. Checks the hint and its next
+    // neighbour before falling back to the binary search.
+    size_t floor_index(uint64_t t, size_t hint) const {
+        size_t n = ts_.size();
+        if (hint < n && ts_[hint] <= t) {
+            if (hint + 1 == n || t < ts_[hint + 1]) return hint;
+            if (hint + 2 == n || t < ts_[hint + 2]) return hint + 1;
+        }
+        return floor_index(t);
+    }
+
+    size_t find(uint64_t t, size_t hint = 0) const {
+        if (ts_.empty()) return npos;
+        size_t i = floor_index(t, hint);
+        return ts_[i] == t ? i : npos;
+    }
+
+    // The series must not be empty.
+    Bracket bracket(uint64_t t, size_t hint = 0) const {
+        size_t lo = floor_index(t, hint);
+        if (t <= ts_[lo] || lo + 1 == ts_.size()) return {lo, lo, T(0)};
+        T alpha = static_cast<T>(static_cast<double>(t - ts_[lo]) /
+                                 static_cast<double>(ts_[lo + 1] - ts_[lo]));
+        return {lo, lo + 1, alpha};
+    }
+
+    // Linear interpolation of one channel; clamps outside the series.
+    T interpolate(size_t c, const Bracket& b) const {
+        return values_[c][b.lo] + b.alpha * (values_[c][b.hi] - values_[c][b.lo]);
+    }
+
+    // Amortized O(1) lookups for a reader whose query times mostly increase.
+    class Cursor {
+    public:
+        explicit Cursor(const TimeSeries& series) : series_{&series}, hint_{0} { }
+
+        size_t seek(uint64_t t) {
+            hint_ = series_->floor_index(t, hint_);
+            return hint_;
+        }
+
+        Bracket bracket(uint64_t t) {
+            Bracket b = series_->bracket(t, hint_);
+            hint_     = b.lo;
+            return b;
+        }
+
+    private:
+        const TimeSeries* series_;
+        size_t            hint_;
+    };
+
+private:
+    std::vector<uint64_t>                 ts_;
+    std::array<std::vector<T>, Channels>  values_;
+};
+
+} // namespace ILLIXR
@@ -0,0 +1,14 @@
+// Host clock for native_sim builds (see src/mtime.hpp).
+//
+// Compiled into the native simulator runner rather than the Zephyr image, so
+// it sees the host C library: the embedded side cannot call clock_gettime()
+// itself when it is built against Zephyr's libc.
+
+#include <stdint.h>
+#include <time.h>
+
+uint64_t illixr_host_clock_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
@@ -0,0 +1,63 @@
+#include "latency_tracker.hpp"
+#include "mtime.hpp"
+
+#include <zephyr/kernel.h>
+
+#include <algorithm>
+#include <cstdio>
+
+namespace ILLIXR {
+
+static const char* const kStageNames[] = {
+    "cam_to_vio",
+    "vio_update",
+    "imu_to_render",
+    "cam_to_render",
+};
+
+LatencyTracker& get_latency_tracker() {
+    static LatencyTracker tracker;
+    return tracker;
+}
+
+static double ticks_to_us(uint64_t ticks) {
+    return static_cast<double>(ticks) * 1e6 / static_cast<double>(kMtimeHz);
+}
+
+// Nearest-rank percentile over a sorted array.
+static uint64_t percentile(const uint64_t* sorted, size_t n, double p) {
+    size_t rank = static_cast<size_t>(p * static_cast<double>(n) + 0.999999);
+    if (rank == 0) rank = 1;
+    if (rank > n)  rank = n;
+    return sorted[rank - 1];
+}
+
+void LatencyTracker::report() {
+    if (!atomic_cas(&reported_, 0, 1)) return;
+    while (atomic_get(&recording_) != 0) k_yield();
+
+    // Static scratch keeps the sort copy off the caller's stack.
+    static uint64_t scratch[LATENCY_MAX_SAMPLES];
+
+    printf("\n[latency] ===== motion-to-pose latency (us) =====\n");
+    for (size_t s = 0; s < static_cast<size_t>(LatencyStage::count); s++) {
+        const StageLog& log = stages_[s];
+        if (log.total == 0) {
+            printf("[latency] stage=%-14s n=0\n", kStageNames[s]);
+            continue;
+        }
+
+        size_t kept = std::min(log.total, LATENCY_MAX_SAMPLES);
+        std::copy(log.samples, log.samples + kept, scratch);
+        std::sort(scratch, scratch + kept);
+
+        printf("[latency] stage=%-14s n=%zu p50=%.1f p99=%.1f max=%.1f\n",
+               kStageNames[s], log.total,
+               ticks_to_us(percentile(scratch, kept, 0.50)),
+               ticks_to_us(percentile(scratch, kept, 0.99)),
+               ticks_to_us(log.max));
+    }
+    printf("[latency] ==========================================\n\n");
+}
+
+} // namespace ILLIXR
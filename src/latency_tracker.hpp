@@ -0,0 +1,81 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <zephyr/sys/atomic.h>
+
+// ==============================================================================
+// LATENCY TRACKER — per-stage motion-to-pose latency
+//
+// Every sensor message carries a Provenance (data_format.hpp) stamped by its
+// producer with the CLINT mtime at ingest. Downstream stages call record()
+// with the provenance mtime and the current mtime, and Runtime::shutdown()
+// prints p50/p99/max per stage with report().
+//
+// Each stage has exactly one writer thread, so record() takes no lock:
+//   cam_to_vio, vio_update      → openvins thread
+//   imu_to_render, cam_to_render → imu_integrator thread (the VIO state's
+//                                  camera provenance reaches it through a
+//                                  message queue)
+//
+// Other plugins may still be recording when report() runs. It closes the
+// tracker first and waits for records in progress; later ones are dropped.
+//
+// Only the most recent LATENCY_MAX_SAMPLES samples per stage are kept for the
+// percentiles; max and count cover the whole run.
+// ==============================================================================
+
+namespace ILLIXR {
+
+enum class LatencyStage : uint8_t {
+    cam_to_vio,     // offline_cam emits frame   → openvins dequeues it
+    vio_update,     // openvins dequeues frame   → openvins publishes pose
+    imu_to_render,  // offline_imu emits sample  → imu_integrator publishes to renderer
+    cam_to_render,  // offline_cam emits frame   → first renderer pose from that VIO update
+    count,
+};
+
+constexpr size_t LATENCY_MAX_SAMPLES = 1024;
+
+class LatencyTracker {
+public:
+    LatencyTracker() {
+        atomic_set(&reported_, 0);
+        atomic_set(&recording_, 0);
+    }
+
+    void record(LatencyStage stage, uint64_t start_mtime, uint64_t end_mtime) {
+        atomic_inc(&recording_);
+        if (!atomic_get(&reported_)) append(stage, start_mtime, end_mtime);
+        atomic_dec(&recording_);
+    }
+
+    /**
+     * Print p50/p99/max per stage. Only the first call prints.
+     */
+    void report();
+
+private:
+    struct StageLog {
+        uint64_t samples[LATENCY_MAX_SAMPLES];
+        size_t   total;
+        uint64_t max;
+    };
+
+    StageLog stages_[static_cast<size_t>(LatencyStage::count)]{};
+    atomic_t reported_;
+    atomic_t recording_;   // record() calls in progress
+
+    void append(LatencyStage stage, uint64_t start_mtime, uint64_t end_mtime) {
+        StageLog& log = stages_[static_cast<size_t>(stage)];
+        uint64_t  dt  = (end_mtime > start_mtime) ? end_mtime - start_mtime : 0;
+
+        log.samples[log.total % LATENCY_MAX_SAMPLES] = dt;
+        ++log.total;
+        if (dt > log.max) log.max = dt;
+    }
+};
+
+LatencyTracker& get_latency_tracker();
+
+} // namespace ILLIXR
@@ -0,0 +1,287 @@
+#include "lock_audit.hpp"
+
+#include <cstdio>
+
+#ifdef ILLIXR_LOCK_AUDIT
+
+#include <algorithm>
+#include <climits>
+#include "mtime.hpp"
+
+namespace ILLIXR {
+
+constexpr size_t MAX_AUDITED_LOCKS = 24;
+
+enum class LockKind : uint8_t { mutex, sem, msgq };
+
+static const char* const kKindNames[] = { "mutex", "sem", "msgq" };
+
+// No thread has released the lock yet.
+constexpr int kNoPrio = INT_MIN;
+
+struct LockStats {
+    const void* obj;
+    const char* name;
+    LockKind    kind;
+
+    uint32_t acquisitions;
+    uint32_t contended;
+    uint32_t inversions;
+    uint32_t over_bound;
+
+    uint64_t total_wait;
+    uint64_t max_wait;
+    uint64_t max_hold;
+    const char* max_wait_thread;
+
+    uint64_t acquired_at;     // mutex only: mtime of the outermost lock
+    int      producer_prio;   // last thread to give / put
+    int      consumer_prio;   // last thread to get
+};
+
+static struct k_spinlock audit_lock;
+static LockStats        audit_stats[MAX_AUDITED_LOCKS];
+static size_t           audit_count    = 0;
+static uint32_t         audit_overflow = 0;
+
+static constexpr uint64_t kBoundTicks =
+    static_cast<uint64_t>(ILLIXR_LOCK_AUDIT_BOUND_US) * kMtimeHz / 1000000ULL;
+
+// Called with audit_lock held. Entries are never removed, so the returned
+// pointer stays valid after the lock is dropped.
+static LockStats* find_or_add(const void* obj, const char* name, LockKind kind) {
+    for (size_t i = 0; i < audit_count; i++) {
+        if (audit_stats[i].obj == obj) return &audit_stats[i];
+    }
+    if (audit_count >= MAX_AUDITED_LOCKS) {
+        ++audit_overflow;
+        return nullptr;
+    }
+    LockStats& st    = audit_stats[audit_count++];
+    st               = LockStats{};
+    st.obj           = obj;
+    st.name          = name;
+    st.kind          = kind;
+    st.producer_prio = kNoPrio;
+    st.consumer_prio = kNoPrio;
+    return &st;
+}
+
+static int current_prio() {
+    return k_thread_priority_get(k_current_get());
+}
+
+static const char* current_name() {
+    const char* n = k_thread_name_get(k_current_get());
+    return n ? n : "?";
+}
+
+// Zephyr: numerically lower priority value = more urgent thread.
+static bool is_inversion(int waiter_prio, int releaser_prio) {
+    return releaser_prio != kNoPrio && releaser_prio > waiter_prio;
+}
+
+static void note_acquire(const void* obj, const char* name, LockKind kind,
+                         uint64_t wait, bool contended, bool inverted) {
+    k_spinlock_key_t key = k_spin_lock(&audit_lock);
+    LockStats* st = find_or_add(obj, name, kind);
+    if (st) {
+        ++st->acquisitions;
+        st->total_wait += wait;
+        if (contended)          ++st->contended;
+        if (inverted)           ++st->inversions;
+        if (wait > kBoundTicks) ++st->over_bound;
+        if (wait > st->max_wait) {
+            st->max_wait        = wait;
+            st->max_wait_thread = current_name();
+        }
+    }
+    k_spin_unlock(&audit_lock, key);
+}
+
+// Remembers who last released a sem/msgq so a blocked waiter can tell whether
+// it was waiting on a lower-priority thread.
+static void note_release(const void* obj, const char* name, LockKind kind, bool producer) {
+    int prio = current_prio();
+    k_spinlock_key_t key = k_spin_lock(&audit_lock);
+    LockStats* st = find_or_add(obj, name, kind);
+    if (st) {
+        if (producer) st->producer_prio = prio;
+        else          st->consumer_prio = prio;
+    }
+    k_spin_unlock(&audit_lock, key);
+}
+
+static int releaser_prio(const void* obj, bool producer) {
+    int prio = kNoPrio;
+    k_spinlock_key_t key = k_spin_lock(&audit_lock);
+    for (size_t i = 0; i < audit_count; i++) {
+        if (audit_stats[i].obj == obj) {
+            prio = producer ? audit_stats[i].producer_prio : audit_stats[i].consumer_prio;
+            break;
+        }
+    }
+    k_spin_unlock(&audit_lock, key);
+    return prio;
+}
+
+// =============================================================================
+// MUTEX
+// =============================================================================
+
+int audit_mutex_lock(struct k_mutex* m, k_timeout_t timeout, const char* name) {
+    uint64_t t0 = read_mtime();
+    int      rc = k_mutex_lock(m, K_NO_WAIT);
+
+    bool contended = (rc != 0);
+    bool inverted  = false;
+    if (contended) {
+        // Racy snapshot of the owner, good enough for a debug counter.
+        // owner_orig_prio is the owner's priority before any inheritance boost.
+        if (m->owner) inverted = is_inversion(current_prio(), m->owner_orig_prio);
+        if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT)) rc = k_mutex_lock(m, timeout);
+    }
+    uint64_t t1 = read_mtime();
+
+    note_acquire(m, name, LockKind::mutex, t1 - t0, contended, inverted);
+
+    if (rc == 0 && m->lock_count == 1) {
+        k_spinlock_key_t key = k_spin_lock(&audit_lock);
+        LockStats* st = find_or_add(m, name, LockKind::mutex);
+        if (st) st->acquired_at = t1;
+        k_spin_unlock(&audit_lock, key);
+    }
+    return rc;
+}
+
+int audit_mutex_unlock(struct k_mutex* m) {
+    if (m->owner == k_current_get() && m->lock_count == 1) {
+        uint64_t now = read_mtime();
+        k_spinlock_key_t key = k_spin_lock(&audit_lock);
+        for (size_t i = 0; i < audit_count; i++) {
+            LockStats& st = audit_stats[i];
+            if (st.obj != m) continue;
+            uint64_t hold = now - st.acquired_at;
+            if (hold > st.max_hold) st.max_hold = hold;
+            break;
+        }
+        k_spin_unlock(&audit_lock, key);
+    }
+    return k_mutex_unlock(m);
+}
+
+// =============================================================================
+// SEMAPHORE
+// =============================================================================
+
+int audit_sem_take(struct k_sem* s, k_timeout_t timeout, const char* name) {
+    uint64_t t0 = read_mtime();
+    int      rc = k_sem_take(s, K_NO_WAIT);
+
+    bool contended = (rc != 0);
+    if (contended && !K_TIMEOUT_EQ(timeout, K_NO_WAIT)) rc = k_sem_take(s, timeout);
+    uint64_t t1 = read_mtime();
+
+    // The giver that woke us recorded its priority before giving.
+    bool inverted = contended && rc == 0 &&
+                    is_inversion(current_prio(), releaser_prio(s, true));
+    note_acquire(s, name, LockKind::sem, t1 - t0, contended, inverted);
+    return rc;
+}
+
+void audit_sem_give(struct k_sem* s, const char* name) {
+    note_release(s, name, LockKind::sem, true);
+    k_sem_give(s);
+}
+
+// =============================================================================
+// MESSAGE QUEUE
+//   get blocks on an empty queue → released by a put (producer)
+//   put blocks on a full queue   → released by a get (consumer)
+// =============================================================================
+
+int audit_msgq_put(struct k_msgq* q, const void* data, k_timeout_t timeout, const char* name) {
+    note_release(q, name, LockKind::msgq, true);
+
+    uint64_t t0 = read_mtime();
+    int      rc = k_msgq_put(q, data, K_NO_WAIT);
+
+    bool contended = (rc != 0);
+    if (contended && !K_TIMEOUT_EQ(timeout, K_NO_WAIT)) rc = k_msgq_put(q, data, timeout);
+    uint64_t t1 = read_mtime();
+
+    bool inverted = contended && rc == 0 &&
+                    is_inversion(current_prio(), releaser_prio(q, false));
+    note_acquire(q, name, LockKind::msgq, t1 - t0, contended, inverted);
+    return rc;
+}
+
+int audit_msgq_get(struct k_msgq* q, void* data, k_timeout_t timeout, const char* name) {
+    note_release(q, name, LockKind::msgq, false);
+
+    uint64_t t0 = read_mtime();
+    int      rc = k_msgq_get(q, data, K_NO_WAIT);
+
+    bool contended = (rc != 0);
+    if (contended && !K_TIMEOUT_EQ(timeout, K_NO_WAIT)) rc = k_msgq_get(q, data, timeout);
+    uint64_t t1 = read_mtime();
+
+    bool inverted = contended && rc == 0 &&
+                    is_inversion(current_prio(), releaser_prio(q, true));
+    note_acquire(q, name, LockKind::msgq, t1 - t0, contended, inverted);
+    return rc;
+}
+
+// =============================================================================
+// REPORT
+// =============================================================================
+
+static double ticks_to_us(uint64_t ticks) {
+    return static_cast<double>(ticks) * 1e6 / static_cast<double>(kMtimeHz);
+}
+
+void lock_audit_report() {
+    // Static scratch keeps the sort copy off the caller's stack.
+    static LockStats snapshot[MAX_AUDITED_LOCKS];
+
+    k_spinlock_key_t key = k_spin_lock(&audit_lock);
+    size_t   n        = audit_count;
+    uint32_t overflow = audit_overflow;
+    std::copy(audit_stats, audit_stats + n, snapshot);
+    k_spin_unlock(&audit_lock, key);
+
+    // Contention hot spots first.
+    std::sort(snapshot, snapshot + n, [](const LockStats& a, const LockStats& b) {
+        return a.total_wait > b.total_wait;
+    });
+
+    printf("\n[lock_audit] ===== lock contention (us, bound=%d us) =====\n",
+           ILLIXR_LOCK_AUDIT_BOUND_US);
+    for (size_t i = 0; i < n; i++) {
+        const LockStats& st = snapshot[i];
+        printf("[lock_audit] %-20s %-5s acq=%u contended=%u wait_total=%.1f "
+               "wait_max=%.1f (%s) hold_max=%.1f inversions=%u over_bound=%u\n",
+               st.name, kKindNames[static_cast<size_t>(st.kind)],
+               st.acquisitions, st.contended,
+               ticks_to_us(st.total_wait), ticks_to_us(st.max_wait),
+               st.max_wait_thread ? st.max_wait_thread : "-",
+               ticks_to_us(st.max_hold), st.inversions, st.over_bound);
+    }
+    if (overflow) {
+        printf("[lock_audit] WARNING: %u calls on locks beyond MAX_AUDITED_LOCKS=%zu not recorded\n",
+               overflow, MAX_AUDITED_LOCKS);
+    }
+    printf("[lock_audit] ================================================\n\n");
+}
+
+} // namespace ILLIXR
+
+#else
+
+namespace ILLIXR {
+
+void lock_audit_report() { }
+
+} // namespace ILLIXR
+
+#endif // ILLIXR_LOCK_AUDIT
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <zephyr/kernel.h>
+#include <stdint.h>
+
+// ==============================================================================
+// LOCK AUDIT — debug instrumentation for hot-path locks
+//
+// The hot path goes through phonebook_new::mutex_, the stoplight semaphores and
+// the openvins / imu_integrator message queues. Call sites use the audit_*
+// wrappers below instead of the raw k_* calls:
+//
+//   audit_mutex_lock(&mutex_, K_FOREVER, "phonebook");
+//   audit_sem_take(&stoplight_cam, K_FOREVER, "stoplight_cam");
+//   audit_msgq_get(&openvins_cam_queue, &ptr, K_FOREVER, "openvins_cam_queue");
+//
+// Normal build: every wrapper is an inline pass-through, zero cost.
+//
+// -DILLIXR_LOCK_AUDIT=ON: each wrapper also records, per lock object,
+//   - acquisitions and how many of them had to block (contended)
+//   - total / max wait time, and max hold time for mutexes
+//   - priority inversions: a thread blocked on something only a lower-priority
+//     thread can release (the mutex owner, or the last giver/putter/getter of
+//     a semaphore or queue)
+//   - waits longer than ILLIXR_LOCK_AUDIT_BOUND_US
+// lock_audit_report() prints the locks sorted by total wait at shutdown.
+//
+// The name is only read on the first call for a given object, so pass the
+// same string literal everywhere.
+// ==============================================================================
+
+namespace ILLIXR {
+
+#ifdef ILLIXR_LOCK_AUDIT
+
+#ifndef ILLIXR_LOCK_AUDIT_BOUND_US
+#define ILLIXR_LOCK_AUDIT_BOUND_US 1000
+#endif
+
+int audit_mutex_lock(struct k_mutex* m, k_timeout_t timeout, const char* name);
+int audit_mutex_unlock(struct k_mutex* m);
+
+int  audit_sem_take(struct k_sem* s, k_timeout_t timeout, const char* name);
+void audit_sem_give(struct k_sem* s, const char* name);
+
+int audit_msgq_put(struct k_msgq* q, const void* data, k_timeout_t timeout, const char* name);
+int audit_msgq_get(struct k_msgq* q, void* data, k_timeout_t timeout, const char* name);
+
+#else
+
+static inline int audit_mutex_lock(struct k_mutex* m, k_timeout_t timeout, const char*) {
+    return k_mutex_lock(m, timeout);
+}
+static inline int audit_mutex_unlock(struct k_mutex* m) {
+    return k_mutex_unlock(m);
+}
+
+static inline int audit_sem_take(struct k_sem* s, k_timeout_t timeout, const char*) {
+    return k_sem_take(s, timeout);
+}
+static inline void audit_sem_give(struct k_sem* s, const char*) {
+    k_sem_give(s);
+}
+
+static inline int audit_msgq_put(struct k_msgq* q, const void* data, k_timeout_t timeout, const char*) {
+    return k_msgq_put(q, data, timeout);
+}
+static inline int audit_msgq_get(struct k_msgq* q, void* data, k_timeout_t timeout, const char*) {
+    return k_msgq_get(q, data, timeout);
+}
+
+#endif // ILLIXR_LOCK_AUDIT
+
+// Prints the per-lock table. No-op unless built with ILLIXR_LOCK_AUDIT.
+void lock_audit_report();
+
+} // namespace ILLIXR
@@ -4,7 +4,19 @@
 #include <stdint.h> // For uint64_t
 #include "phonebook_new.hpp"
 #include "runtime.hpp"
+#include "generated_config.hpp"
+#ifdef ILLIXR_DATASET_PACK_FS_PATH
+#include "dataset_pack.hpp"
+#endif
 
+#if defined(CONFIG_ARCH_POSIX)
+#include <posix_board_if.h>
+
+// native_sim: end the host process with the exit code.
+void firesim_exit(int code) {
+    posix_exit(code);
+}
+#else
 extern "C" {
     extern volatile uint64_t tohost;
     extern volatile uint64_t fromhost;
@@ -15,6 +27,7 @@ void firesim_exit(int code) {
     tohost = (uint64_t)((code << 1) | 1);
     while (1); 
 }
+#endif
 // --------------------------
 
 uint64_t g_program_start_mtime = 0;
@@ -26,13 +39,16 @@ int main() {
     auto& pb = ILLIXR::get_phonebook();
     ILLIXR::Runtime runtime(pb);
 
-    const char* data_path      = "../data/V1_02_medium/mav0";
-    const char* demo_data_path = "../demo_data";
-
-    runtime.initialize(data_path, demo_data_path);
+    // From the profile's data: / demo_data: keys.
+    runtime.initialize(DATA_PATH, DEMO_DATA_PATH);
+#ifdef ILLIXR_DATASET_PACK_FS_PATH
+    // Plugin constructors open the pack.
+    illixr_mount_dataset_pack_fs();
+#endif
     runtime.start_all_plugins();
     // INcluding the runtime thread itself timing. Need better way to figure out runtime whole time
-    k_sleep(K_SECONDS(500000));
+    // Openvins signals pipeline_done after the last frame; the timeout is the old fixed run length.
+    k_sem_take(&pipeline_done, K_SECONDS(500000));
 
     runtime.shutdown();
 
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <stdint.h>
+
+// ==============================================================================
+// PLATFORM CLOCK
+//
+// read_mtime() is the one clock every timing path uses (latency tracker, lock
+// audit, skip_to_latest pacing, per-plugin stats). It counts kMtimeHz ticks
+// on every board, so consumers never need to know which backend they run on:
+//
+//   spike_riscv64         CLINT mtime at 0x200bff8 (spike DTS): global
+//                         real-time counter shared by all harts, 10 MHz
+//   native_sim/native/64  host CLOCK_MONOTONIC read from the runner side
+//                         (src/host_clock.c), scaled to the same 10 MHz.
+//                         Zephyr's own cycle counter is simulated time there
+//                         and does not advance while a thread computes.
+// ==============================================================================
+
+static constexpr uint64_t kMtimeHz = 10000000ULL;
+
+#if defined(CONFIG_ARCH_POSIX)
+
+extern "C" uint64_t illixr_host_clock_ns(void);
+
+static inline uint64_t read_mtime() {
+    return illixr_host_clock_ns() / (1000000000ULL / kMtimeHz);
+}
+
+#else
+
+static inline uint64_t read_mtime() {
+    volatile uint64_t* mtime = reinterpret_cast<volatile uint64_t*>(0x200bff8UL);
+    return *mtime;
+}
+
+#endif
@@ -26,11 +26,11 @@ class Node {
 public:
     typedef void (*MsgCallbackFn)(void* context, const void* msg);
 
-    Node() : pb_{nullptr} {
+    Node() : pb_{nullptr}, shutdown_cb_{nullptr}, shutdown_ctx_{nullptr} {
         name_[0] = '\0';
     }
 
-    explicit Node(const char* name) : pb_{nullptr} {
+    explicit Node(const char* name) : pb_{nullptr}, shutdown_cb_{nullptr}, shutdown_ctx_{nullptr} {
         strncpy(name_, name, MAX_PLUGIN_NAME_LEN - 1);
         name_[MAX_PLUGIN_NAME_LEN - 1] = '\0';
     }
@@ -50,6 +50,17 @@ public:
         pb_->subscribe<MsgT>(sender_name, name_, callback, context);
     }
 
+    // Subscribe to a named channel rather than to messages addressed to this
+    // node, e.g. subscribe_to<PoseMsg>("openvins", "openvins_pose", ...).
+    template<typename MsgT>
+    void subscribe_to(const char* sender_name,
+                      const char* channel,
+                      void (*callback)(void* ctx, const MsgT&),
+                      void* context) {
+        if (!pb_) { return; }
+        pb_->subscribe<MsgT>(sender_name, channel, callback, context);
+    }
+
     template<typename MsgT>
     void publish_to(const char* receiver_name, const MsgT& msg) {
         if (!pb_) { return; }
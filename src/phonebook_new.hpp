@@ -6,6 +6,7 @@
 #include <stddef.h>
 #include <string.h>
 #include <cstdio>
+#include "lock_audit.hpp"
 
 namespace ILLIXR {
 
@@ -14,6 +15,7 @@ class Node;
 constexpr size_t MAX_PLUGINS                 = 10;
 constexpr size_t MAX_CHANNELS                = 20;
 constexpr size_t MAX_SUBSCRIBERS_PER_CHANNEL = 4;
+constexpr size_t MAX_SERVICES                = 8;
 
 class phonebook_new {
 public:
@@ -22,32 +24,32 @@ public:
         Node*       instance;
     };
 
-    phonebook_new() : count_(0), channel_count_(0) {
+    phonebook_new() : count_(0), channel_count_(0), service_count_(0) {
         k_mutex_init(&mutex_);
     }
 
     bool register_plugin(const char* name, Node* instance) {
         printf("Registering plugin: %s\n", name);
-        k_mutex_lock(&mutex_, K_FOREVER);
+        audit_mutex_lock(&mutex_, K_FOREVER, "phonebook");
         if (count_ >= MAX_PLUGINS) {
-            k_mutex_unlock(&mutex_);
+            audit_mutex_unlock(&mutex_);
             return false;
         }
         entries_[count_++] = {name, instance};
-        k_mutex_unlock(&mutex_);
+        audit_mutex_unlock(&mutex_);
         return true;
     }
 
     Node* lookup(const char* name) {
-        k_mutex_lock(&mutex_, K_FOREVER);
+        audit_mutex_lock(&mutex_, K_FOREVER, "phonebook");
         for (size_t i = 0; i < count_; i++) {
             if (strcmp(name, entries_[i].name) == 0) {
                 Node* node = entries_[i].instance;
-                k_mutex_unlock(&mutex_);
+                audit_mutex_unlock(&mutex_);
                 return node;
             }
         }
-        k_mutex_unlock(&mutex_);
+        audit_mutex_unlock(&mutex_);
         return nullptr;
     }
 
@@ -57,6 +59,44 @@ public:
     const Entry* end()   const { return entries_ + count_; }
     size_t       size()  const { return count_; }
 
+    // =========================================================================
+    // SERVICES
+    //
+    // Plugins that answer queries (e.g. ground truth) register an
+    // implementation under its interface type from their constructor. The
+    // runtime constructs and starts plugins one at a time, in registration
+    // order, so a constructor or _p_thread_setup() only sees providers started
+    // before it. Look services up lazily (e.g. from the first callback that
+    // needs one, retrying while it returns nullptr) to be order-independent.
+    // =========================================================================
+
+    template<typename T>
+    bool register_impl(T* impl) {
+        audit_mutex_lock(&mutex_, K_FOREVER, "phonebook");
+        if (service_count_ >= MAX_SERVICES) {
+            audit_mutex_unlock(&mutex_);
+            return false;
+        }
+        services_[service_count_++] = {type_id<T>(), impl};
+        audit_mutex_unlock(&mutex_);
+        return true;
+    }
+
+    // nullptr if no plugin provides T.
+    template<typename T>
+    T* lookup_impl() {
+        T* impl = nullptr;
+        audit_mutex_lock(&mutex_, K_FOREVER, "phonebook");
+        for (size_t i = 0; i < service_count_; i++) {
+            if (services_[i].type_id == type_id<T>()) {
+                impl = static_cast<T*>(services_[i].impl);
+                break;
+            }
+        }
+        audit_mutex_unlock(&mutex_);
+        return impl;
+    }
+
     // =========================================================================
     // MESSAGING
     // =========================================================================
@@ -86,17 +126,17 @@ public:
                    void (*cb)(void*, const MsgT&),
                    void* ctx)
     {
-        k_mutex_lock(&mutex_, K_FOREVER);
+        audit_mutex_lock(&mutex_, K_FOREVER, "phonebook");
         Channel* ch = find_or_create_channel(sender, receiver);
         if (!ch || ch->sub_count >= MAX_SUBSCRIBERS_PER_CHANNEL) {
-            k_mutex_unlock(&mutex_);
+            audit_mutex_unlock(&mutex_);
             return;
         }
         Subscriber& s = ch->subs[ch->sub_count++];
         s.context  = ctx;
         s.callback = reinterpret_cast<void (*)(void*, const void*)>(cb);
         s.type_id  = type_id<MsgT>();
-        k_mutex_unlock(&mutex_);
+        audit_mutex_unlock(&mutex_);
     }
 
     // -------------------------------------------------------------------------
@@ -127,7 +167,7 @@ public:
         size_t     snap_count = 0;
         uintptr_t  tid        = type_id<MsgT>();
 
-        k_mutex_lock(&mutex_, K_FOREVER);
+        audit_mutex_lock(&mutex_, K_FOREVER, "phonebook");
         Channel* ch = find_channel(sender, receiver);
         if (ch) {
             for (size_t i = 0; i < ch->sub_count; i++) {
@@ -136,7 +176,7 @@ public:
                 }
             }
         }
-        k_mutex_unlock(&mutex_);   // ← released BEFORE any callback fires
+        audit_mutex_unlock(&mutex_);   // ← released BEFORE any callback fires
 
         // --- 2. Invoke callbacks outside lock --------------------------------
         for (size_t i = 0; i < snap_count; i++) {
@@ -154,6 +194,13 @@ private:
     Channel channels_[MAX_CHANNELS];
     size_t  channel_count_;
 
+    struct Service {
+        uintptr_t type_id;
+        void*     impl;
+    };
+    Service services_[MAX_SERVICES];
+    size_t  service_count_;
+
     Channel* find_channel(const char* sender, const char* receiver) {
         for (size_t i = 0; i < channel_count_; i++) {
             if (!strcmp(channels_[i].sender,   sender) &&
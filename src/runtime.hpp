@@ -5,19 +5,16 @@
 #include <stdio.h>
 #include <stdint.h>
 #include "phonebook_new.hpp"
+#include "node.hpp"
 #include "plugin_registry.hpp"
 #include "stoplight.hpp"   // extern declarations only — definitions are in stoplight.cpp
+#include "latency_tracker.hpp"
+#include "lock_audit.hpp"
+#include "mtime.hpp"
 
 // Defined in main.cpp; recorded here at the moment data flow begins.
 extern uint64_t g_program_start_mtime;
 
-// CLINT mtime: global real-time counter shared across all harts.
-// Address 0x200bff8 from the spike DTS. Safe to compare across CPUs.
-static inline uint64_t read_mtime_runtime() {
-    volatile uint64_t* mtime = reinterpret_cast<volatile uint64_t*>(0x200bff8UL);
-    return *mtime;
-}
-
 namespace ILLIXR {
 
 class Runtime {
@@ -37,8 +34,10 @@ public:
         PluginRegistry& reg = get_plugin_registry();
 
         // ── Step 1: spawn all plugin threads ─────────────────────────────
-        // Order doesn't matter — we wait for all of them below before
-        // any data starts flowing.
+        // Each start_fn constructs its plugin and starts its thread before the
+        // next one runs, in registration order, so a plugin's constructor and
+        // _p_thread_setup() only see services registered by plugins started
+        // before it; see phonebook_new::lookup_impl().
         for (const auto& entry : reg) {
             printf("[runtime] Launching plugin: %s\n", entry.name);
             entry.start_fn(pb_);
@@ -56,7 +55,7 @@ public:
             printf("[runtime] %zu/%zu plugins ready\n", i + 1, reg.size());
         }
 
-        g_program_start_mtime = read_mtime_runtime();
+        g_program_start_mtime = read_mtime();
         printf("[runtime] All %zu plugins ready — data flow begins.\n",
                reg.size());
         printf("[runtime] Timing start: mtime=%llu ticks\n",
@@ -64,7 +63,17 @@ public:
     }
 
     void shutdown() {
+        uint64_t elapsed = read_mtime() - g_program_start_mtime;
         printf("[runtime] Shutting down...\n");
+        // Parsed by bench/run_batch.py.
+        printf("[runtime] pipeline time: %.6f s (%llu ticks)\n",
+               static_cast<double>(elapsed) / static_cast<double>(kMtimeHz),
+               (unsigned long long)elapsed);
+        for (auto& entry : pb_) {
+            entry.instance->shutdown();
+        }
+        get_latency_tracker().report();
+        lock_audit_report();
     }
 
 private:
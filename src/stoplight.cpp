@@ -10,4 +10,10 @@
 // ============================================================================
 K_SEM_DEFINE(stoplight_imu, 0, 1);
 K_SEM_DEFINE(stoplight_cam, 0, 1);
-K_SEM_DEFINE(stoplight_ready, 0, 20);  // max=20 matches MAX_REGISTERED_PLUGINS
\ No newline at end of file
+K_SEM_DEFINE(stoplight_ready, 0, 20);  // max=20 matches MAX_REGISTERED_PLUGINS
+K_SEM_DEFINE(pipeline_done, 0, 1);
+
+// Holds an int64 ns timestamp: needs a 64-bit atomic_val_t (RV64, native_sim/64).
+static_assert(sizeof(atomic_val_t) >= sizeof(int64_t),
+              "imu_request_until_ns stores int64 ns in an atomic_t");
+atomic_t imu_request_until_ns = ATOMIC_INIT(0);
\ No newline at end of file
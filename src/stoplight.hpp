@@ -1,27 +1,40 @@
 #pragma once
 
 #include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
 
 // ==============================================================================
 // STOPLIGHT — flow control between producers (IMU, camera) and consumer (openvins)
 //
 // Protocol:
-//   1. IMU + camera block on their respective semaphores at the START of each window/frame
-//   2. Openvins gives both semaphores after finishing feed_stereo() + update
+//   1. IMU + camera block on their respective semaphores at the START of each request/frame
+//   2. Openvins gives stoplight_cam for the next frame, then — knowing the frame's
+//      timestamp t — stores t in imu_request_until_ns and gives stoplight_imu once.
+//      The IMU producer answers with every sample up to and including the first
+//      one at or after t, so one handshake covers the frame at any IMU/camera rate.
 //   3. This ensures:
 //      - No data is produced faster than openvins can consume
 //      - No heap exhaustion from queued cloned images
 //      - IMU and camera stay in lockstep with each other
 //
-// Initial count = 1 so the first window/frame can proceed without waiting.
+// Initial count = 1 so the first request/frame can proceed without waiting.
 // ==============================================================================
 
-// IMU takes this before each window of 10 samples.
-// Openvins gives it after processing the corresponding camera frame.
+// IMU takes this before each "all IMU up to t" request.
+// Openvins gives it after writing imu_request_until_ns.
 extern struct k_sem stoplight_imu;
 
+// Dataset timestamp (ns) the current IMU request must cover. Written by
+// openvins before giving stoplight_imu, read by the producer after taking it.
+// If the producer runs out of samples first it pushes a nullptr end marker.
+extern atomic_t imu_request_until_ns;
+
 // Camera takes this before each frame.
 // Openvins gives it after processing the frame.
 extern struct k_sem stoplight_cam;
 
-extern struct k_sem stoplight_ready;
\ No newline at end of file
+extern struct k_sem stoplight_ready;
+
+// Openvins gives this once after the last camera frame has been processed.
+// main() waits on it before calling Runtime::shutdown().
+extern struct k_sem pipeline_done;
\ No newline at end of file
@@ -49,6 +49,7 @@ public:
         , stack_{stack}
         , stack_size_{stack_size}
         , priority_{priority}
+        , cpu_{-1}
         , tid_{nullptr}
     {
         atomic_set(&stop_flag_, 0);
@@ -60,6 +61,8 @@ public:
 
         atomic_set(&stop_flag_, 0);
 
+        // A pinned thread is created suspended: the CPU mask can only be
+        // changed before it first runs.
         tid_ = k_thread_create(
             &thread_,
             stack_,
@@ -68,11 +71,21 @@ public:
             this, nullptr, nullptr,
             K_PRIO_PREEMPT(priority_),
             0,
-            K_NO_WAIT
+            cpu_ >= 0 ? K_FOREVER : K_NO_WAIT
         );
 
         if (tid_) {
             k_thread_name_set(tid_, node_.name());
+            if (cpu_ >= 0) {
+#ifdef CONFIG_SCHED_CPU_MASK
+                int rc = k_thread_cpu_pin(tid_, cpu_);
+                printf("[threadloop:%s] pinned to cpu %d rc=%d\n", node_.name(), cpu_, rc);
+#else
+                printf("[threadloop:%s] WARNING: cpu %d requested but CONFIG_SCHED_CPU_MASK "
+                       "is off — not pinned\n", node_.name(), cpu_);
+#endif
+                k_thread_start(tid_);
+            }
             printf("[threadloop:%s] thread spawned tid=%p\n",
                    node_.name(), (void*)tid_);
         } else {
@@ -91,6 +104,10 @@ public:
     }
 
 protected:
+    // Keep the thread on one CPU (call before start()). Needs
+    // CONFIG_SCHED_CPU_MASK; without it the request is reported and ignored.
+    void pin_to_cpu(int cpu) { cpu_ = cpu; }
+
     enum class skip_option {
         run,
         skip_and_spin,
@@ -161,6 +178,7 @@ private:
     k_thread_stack_t* stack_;
     size_t            stack_size_;
     int               priority_;
+    int               cpu_;          // -1: any CPU
     atomic_t          stop_flag_;
     struct k_thread   thread_;
     k_tid_t           tid_;